@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+	struct Result
+	{
+		std::string name;
+		std::size_t operations = 1; // Done by every sample, the times are per operation
+		std::vector<double> samples; // Nanoseconds per operation, sorted
+
+		double Percentile(double percentile) const; // Nearest rank, 50 is the median
+		double Mean() const;
+	};
+
+	// Times every benchmark over a fixed number of samples after a few warm-up runs that are thrown away.
+	// The median and p95 are reported instead of the mean, so a sample interrupted by the OS does not move the numbers.
+	class Runner
+	{
+	public:
+		Runner(std::size_t samples, std::size_t warmup, std::string filter) : samples(samples), warmup(warmup), filter(std::move(filter)) {}
+
+		// setup runs before every sample and is not timed, body gets what it returned and does 'operations' operations on it
+		template<typename Setup, typename Body>
+		void Measure(const std::string& name, std::size_t operations, Setup&& setup, Body&& body)
+		{
+			if (name.find(filter) == std::string::npos) return;
+
+			Result result{ name, operations };
+			result.samples.reserve(samples);
+			for (std::size_t i = 0; i < warmup + samples; i++)
+			{
+				auto state = setup();
+				const auto start = std::chrono::steady_clock::now();
+				body(state);
+				const auto stop = std::chrono::steady_clock::now();
+				if (i < warmup) continue;
+
+				result.samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / double(operations));
+			}
+			Finish(std::move(result));
+		}
+
+		template<typename Body>
+		void Measure(const std::string& name, std::size_t operations, Body&& body)
+		{
+			Measure(name, operations, []() { return 0; }, [&body](int) { body(); });
+		}
+
+		const std::vector<Result>& Results() const { return results; }
+
+	private:
+		void Finish(Result&& result);
+
+		std::size_t samples;
+		std::size_t warmup;
+		std::string filter; // Only benchmarks whose name contains it are run
+		std::vector<Result> results;
+	};
+
+	inline volatile char keep_sink;
+
+	// Keeps the compiler from dropping work whose result is never used
+	template<typename T>
+	void Keep(const T& value)
+	{
+		keep_sink = *reinterpret_cast<const volatile char*>(&value);
+	}
+
+	// Each benchmarks_*.cpp registers its group with a static Register, groups run in name order
+	using Group = void (*)(Runner& runner);
+	struct Register
+	{
+		Register(const char* name, Group group);
+	};
+}
\ No newline at end of file
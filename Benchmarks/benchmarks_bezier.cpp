@@ -0,0 +1,83 @@
+#include <random>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+#include "utils/Bezier.hpp"
+
+using utils::CubicBezier;
+
+namespace benchmarks
+{
+	// Connections as BoardTab builds them, between Posts spread over a large board
+	struct Connections
+	{
+		Connections(std::size_t count)
+		{
+			std::mt19937 generator(1234);
+			std::uniform_real_distribution<float> coordinate(0.f, 4000.f);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				beziers.push_back(utils::GetCubicBezier(ImVec2(coordinate(generator), coordinate(generator)), ImVec2(coordinate(generator), coordinate(generator))));
+				polylines.emplace_back();
+				utils::TessellateCubicBezier(beziers.back(), polylines.back());
+				queries.push_back(ImVec2(coordinate(generator), coordinate(generator)));
+			}
+		}
+
+		std::vector<CubicBezier> beziers;
+		std::vector<std::vector<ImVec2>> polylines;
+		std::vector<ImVec2> queries; // One mouse position per connection
+	};
+
+	static void BezierBenchmarks(Runner& runner)
+	{
+		const Connections connections(1000);
+		const std::size_t count = connections.beziers.size();
+
+		runner.Measure("Bezier/Tessellate/1000 connections", count,
+			[&connections]()
+			{
+				std::vector<ImVec2> polyline;
+				for (const CubicBezier& bezier : connections.beziers)
+				{
+					utils::TessellateCubicBezier(bezier, polyline);
+					Keep(polyline.back());
+				}
+			});
+
+		runner.Measure("Bezier/Polyline bounds/1000 connections", count,
+			[&connections]()
+			{
+				for (const auto& polyline : connections.polylines)
+				{
+					Keep(utils::GetContainingRectForPolyline(polyline, 0.f));
+				}
+			});
+
+		// The distance BoardTab uses to find the hovered connection
+		runner.Measure("Bezier/Distance to polyline/1000 connections", count,
+			[&connections, count]()
+			{
+				float closest = FLT_MAX;
+				for (std::size_t i = 0; i < count; i++)
+				{
+					closest = ImMin(closest, utils::GetDistanceToPolyline(connections.queries[i], connections.polylines[i]));
+				}
+				Keep(closest);
+			});
+
+		runner.Measure("Bezier/Distance to curve/1000 connections", count,
+			[&connections, count]()
+			{
+				float closest = FLT_MAX;
+				for (std::size_t i = 0; i < count; i++)
+				{
+					closest = ImMin(closest, utils::GetDistanceToCubicBezier(connections.queries[i], connections.beziers[i], connections.polylines[i]));
+				}
+				Keep(closest);
+			});
+	}
+
+	static Register bezier("Bezier", BezierBenchmarks);
+}
\ No newline at end of file
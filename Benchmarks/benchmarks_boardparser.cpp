@@ -0,0 +1,76 @@
+#include <cstdio> // std::remove
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+#include "containers/PostContainer.hpp"
+#include "utils/BoardGenerator.hpp"
+#include "utils/parsing/BoardParser.hpp"
+
+using board::PostContainer;
+using utils::BinaryBoardFormat;
+using utils::BoardGenerator;
+using utils::BoardParser;
+using utils::LuaBoardReader;
+using utils::LuaBoardWriter;
+
+namespace benchmarks
+{
+	static void BoardParserBenchmarks(Runner& runner)
+	{
+		const std::size_t count = 1000;
+		BoardGenerator::Options options; // Long tail text, a tag per Post, about as many connections as Posts
+		options.posts = count;
+		const PostContainer board = BoardGenerator::Generate(options);
+		const std::string script = LuaBoardWriter::ToString(board);
+		const std::vector<unsigned char> binary = BinaryBoardFormat::Serialize(board);
+
+		runner.Measure("BoardParser/Serialize Lua/1000 Posts", count,
+			[&board]()
+			{
+				Keep(LuaBoardWriter::ToString(board));
+			});
+
+		runner.Measure("BoardParser/Serialize binary/1000 Posts", count,
+			[&board]()
+			{
+				Keep(BinaryBoardFormat::Serialize(board));
+			});
+
+		runner.Measure("BoardParser/Parse Lua/1000 Posts", count,
+			[&script]()
+			{
+				Keep(LuaBoardReader::Parse(script));
+			});
+
+		runner.Measure("BoardParser/Parse binary/1000 Posts", count,
+			[&binary]()
+			{
+				Keep(BinaryBoardFormat::Parse(binary.data(), binary.size()));
+			});
+
+		// The whole path through the file system, as the Open and Save menu items use it
+		for (const std::string& extension : { std::string("lua"), std::string(BinaryBoardFormat::extension) })
+		{
+			const std::string path = (std::filesystem::temp_directory_path() / ("benchmark_board." + extension)).string();
+
+			runner.Measure("BoardParser/SavePath " + extension + "/1000 Posts", count,
+				[&board, &path]()
+				{
+					BoardParser().SavePath(board, path);
+				});
+
+			runner.Measure("BoardParser/LoadPath " + extension + "/1000 Posts", count,
+				[&path]()
+				{
+					Keep(BoardParser().LoadPath(path));
+				});
+
+			std::remove(path.c_str());
+		}
+	}
+
+	static Register boardparser("BoardParser", BoardParserBenchmarks);
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "Benchmark.hpp"
+
+#include "containers/LuaVector.hpp"
+
+using board::LuaVector;
+using board::LuaVectorAccess;
+
+namespace benchmarks
+{
+	static void LuaVectorBenchmarks(Runner& runner)
+	{
+		const int count = 10000;
+
+		runner.Measure("LuaVector/PushBack/10000", count,
+			[]() { return LuaVector<int>(false); },
+			[](LuaVector<int>& vector)
+			{
+				for (int i = 1; i <= count; i++) vector.PushBack(i);
+				Keep(vector.back());
+			});
+
+		runner.Measure("LuaVector/Index/10000", count,
+			[]()
+			{
+				LuaVector<int> vector(false);
+				for (int i = 1; i <= count; i++) vector.PushBack(i);
+				return vector;
+			},
+			[](LuaVector<int>& vector)
+			{
+				int sum = 0;
+				for (int i = 1; i <= count; i++) sum += vector[i];
+				Keep(sum);
+			});
+
+		runner.Measure("LuaVector/Unchecked index/10000", count,
+			[]()
+			{
+				LuaVector<int, LuaVectorAccess::unchecked> vector;
+				for (int i = 1; i <= count; i++) vector.PushBack(i);
+				return vector;
+			},
+			[](LuaVector<int, LuaVectorAccess::unchecked>& vector)
+			{
+				int sum = 0;
+				for (int i = 1; i <= count; i++) sum += vector[i];
+				Keep(sum);
+			});
+
+		// Every write one past the end goes through the auto resize path
+		runner.Measure("LuaVector/Auto resize index/10000", count,
+			[]() { return LuaVector<int>(true); },
+			[](LuaVector<int>& vector)
+			{
+				for (int i = 1; i <= count; i++) vector[i] = i;
+				Keep(vector.back());
+			});
+
+		runner.Measure("LuaVector/Growing index/10000", count,
+			[]() { return LuaVector<int, LuaVectorAccess::growing>(); },
+			[](LuaVector<int, LuaVectorAccess::growing>& vector)
+			{
+				for (int i = 1; i <= count; i++) vector[i] = i;
+				Keep(vector.back());
+			});
+
+		runner.Measure("LuaVector/Insert front/1000", 1000,
+			[]() { return LuaVector<int>(false); },
+			[](LuaVector<int>& vector)
+			{
+				for (int i = 0; i < 1000; i++) vector.Insert(vector.begin(), i);
+				Keep(vector.front());
+			});
+
+		runner.Measure("LuaVector/Erase front/1000", 1000,
+			[]()
+			{
+				LuaVector<int> vector(false);
+				for (int i = 0; i < 1000; i++) vector.PushBack(i);
+				return vector;
+			},
+			[](LuaVector<int>& vector)
+			{
+				while (!vector.Empty()) vector.Erase(vector.begin());
+				Keep(vector);
+			});
+	}
+
+	static Register luavector("LuaVector", LuaVectorBenchmarks);
+}
\ No newline at end of file
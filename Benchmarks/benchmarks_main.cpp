@@ -0,0 +1,122 @@
+#include <algorithm> // std::sort, std::min
+#include <cmath> // std::ceil
+#include <cstdio>
+#include <cstdlib> // std::strtoul
+#include <cstring> // std::strcmp
+#include <fstream>
+#include <map>
+#include <numeric> // std::accumulate
+
+#include "Benchmark.hpp"
+
+namespace benchmarks
+{
+	static std::map<std::string, Group>& Groups()
+	{
+		static std::map<std::string, Group> groups;
+		return groups;
+	}
+
+	Register::Register(const char* name, Group group)
+	{
+		Groups().emplace(name, group);
+	}
+
+	double Result::Percentile(double percentile) const
+	{
+		if (samples.empty()) return 0.0;
+		const double rank = std::ceil(percentile / 100.0 * double(samples.size()));
+		const std::size_t index = rank < 1.0 ? 0 : std::min(std::size_t(rank) - 1, samples.size() - 1);
+		return samples[index];
+	}
+
+	double Result::Mean() const
+	{
+		if (samples.empty()) return 0.0;
+		return std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+	}
+
+	void Runner::Finish(Result&& result)
+	{
+		std::sort(result.samples.begin(), result.samples.end());
+		std::printf("%-56s %14.1f %14.1f %14.1f\n", result.name.c_str(), result.Percentile(50.0), result.Percentile(95.0), result.samples.front());
+		std::fflush(stdout);
+		results.push_back(std::move(result));
+	}
+
+	static std::string Escape(const std::string& text)
+	{
+		std::string escaped;
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\') escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	static void WriteJson(const std::vector<Result>& results, std::size_t samples, const std::string& path)
+	{
+		std::ofstream out(path);
+		if (!out)
+		{
+			std::fprintf(stderr, "Could not write the report to %s\n", path.c_str());
+			return;
+		}
+
+		#ifdef BOARD_DEBUG
+		const char* configuration = "Debug";
+		#else
+		const char* configuration = "Release";
+		#endif
+
+		out << "{\n\t\"configuration\": \"" << configuration << "\",\n\t\"samples\": " << samples << ",\n\t\"unit\": \"ns/op\",\n\t\"benchmarks\": [";
+		for (std::size_t i = 0; i < results.size(); i++)
+		{
+			const Result& result = results[i];
+			out << (i == 0 ? "\n" : ",\n");
+			out << "\t\t{ \"name\": \"" << Escape(result.name) << "\", \"operations\": " << result.operations
+				<< ", \"median\": " << result.Percentile(50.0) << ", \"p95\": " << result.Percentile(95.0)
+				<< ", \"min\": " << result.samples.front() << ", \"mean\": " << result.Mean() << " }";
+		}
+		out << "\n\t]\n}\n";
+	}
+}
+
+using namespace benchmarks;
+
+int main(int argc, char** argv)
+{
+	std::size_t samples = 30;
+	std::size_t warmup = 3;
+	std::string filter;
+	std::string json_path;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const bool has_value = i + 1 < argc;
+		if (has_value && std::strcmp(argv[i], "--samples") == 0) samples = std::max<std::size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+		else if (has_value && std::strcmp(argv[i], "--warmup") == 0) warmup = std::strtoul(argv[++i], nullptr, 10);
+		else if (has_value && std::strcmp(argv[i], "--filter") == 0) filter = argv[++i];
+		else if (has_value && std::strcmp(argv[i], "--json") == 0) json_path = argv[++i];
+		else
+		{
+			std::printf("Usage: %s [--samples N] [--warmup N] [--filter TEXT] [--json PATH]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	#ifdef BOARD_DEBUG
+	std::printf("Warning: Debug build, the numbers are not comparable to Release ones.\n\n");
+	#endif
+	std::printf("%-56s %14s %14s %14s\n", "ns per operation", "median", "p95", "min");
+
+	Runner runner(samples, warmup, filter);
+	for (const auto& [name, group] : Groups())
+	{
+		group(runner);
+	}
+
+	if (!json_path.empty()) WriteJson(runner.Results(), samples, json_path);
+	return 0;
+}
\ No newline at end of file
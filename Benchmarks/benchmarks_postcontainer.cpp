@@ -0,0 +1,78 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+#include "containers/PostContainer.hpp"
+
+using board::PostContainer;
+
+namespace benchmarks
+{
+	static PostContainer MakeContainer(std::size_t count)
+	{
+		PostContainer container;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			container.CreatePostBack("Post " + std::to_string(i));
+		}
+		return container;
+	}
+
+	// Fixed seed, so every run works on the same positions
+	static std::vector<std::size_t> RandomPositions(std::size_t count, std::size_t size)
+	{
+		std::mt19937 generator(1234);
+		std::vector<std::size_t> positions;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			positions.push_back(std::uniform_int_distribution<std::size_t>(1, size - i)(generator)); // Still valid after i erases
+		}
+		return positions;
+	}
+
+	static void PostContainerBenchmarks(Runner& runner)
+	{
+		const std::size_t edits = 100;
+
+		for (std::size_t count : { 1000, 10000, 100000 })
+		{
+			const std::string size = "/" + std::to_string(count);
+			const PostContainer prototype = MakeContainer(count);
+			const std::vector<std::size_t> positions = RandomPositions(edits, count);
+			const auto copy = [&prototype]() { return prototype; };
+
+			runner.Measure("PostContainer/CreatePostBack" + size, count,
+				[]() { return PostContainer(); },
+				[count](PostContainer& container)
+				{
+					for (std::size_t i = 0; i < count; i++) container.CreatePostBack("Post");
+					Keep(container.size());
+				});
+
+			runner.Measure("PostContainer/Insert front" + size, edits, copy,
+				[](PostContainer& container)
+				{
+					for (std::size_t i = 0; i < edits; i++) container.Insert(container.begin(), board::Post("Inserted"));
+					Keep(container.size());
+				});
+
+			runner.Measure("PostContainer/Erase random" + size, edits, copy,
+				[&positions](PostContainer& container)
+				{
+					for (std::size_t position : positions) container.Erase(container.IteratorFromIndex(position));
+					Keep(container.size());
+				});
+
+			runner.Measure("PostContainer/MoveToLastPosition random" + size, edits, copy,
+				[&positions](PostContainer& container)
+				{
+					for (std::size_t position : positions) container.MoveToLastPosition(position);
+					Keep(container.size());
+				});
+		}
+	}
+
+	static Register postcontainer("PostContainer", PostContainerBenchmarks);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+#include "renderables/posts/Tags.hpp"
+
+using board::Tags;
+
+namespace benchmarks
+{
+	static std::vector<std::string> Keys(std::size_t count)
+	{
+		std::vector<std::string> keys;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			keys.push_back("tag_" + std::to_string(i));
+		}
+		return keys;
+	}
+
+	static Tags MakeTags(const std::vector<std::string>& keys, int values)
+	{
+		Tags tags;
+		for (const std::string& key : keys)
+		{
+			for (int value = 0; value < values; value++) tags[key].EmplaceBack(value);
+		}
+		return tags;
+	}
+
+	static void TagsBenchmarks(Runner& runner)
+	{
+		const std::vector<std::string> keys = Keys(1000);
+		const Tags prototype = MakeTags(keys, 4);
+
+		runner.Measure("Tags/Add 4 values/1000 keys", keys.size(),
+			[]() { return Tags(); },
+			[&keys](Tags& tags)
+			{
+				for (const std::string& key : keys)
+				{
+					for (int value = 0; value < 4; value++) tags[key].EmplaceBack(value);
+				}
+				Keep(tags);
+			});
+
+		runner.Measure("Tags/HasTag/1000 keys", keys.size(),
+			[&prototype]() { return &prototype; },
+			[&keys](const Tags* tags)
+			{
+				std::size_t found = 0;
+				for (const std::string& key : keys) found += tags->HasTag(key);
+				Keep(found);
+			});
+
+		runner.Measure("Tags/RemoveFromKey last value/1000 keys", keys.size(),
+			[&prototype]() { return prototype; },
+			[&keys](Tags& tags)
+			{
+				for (const std::string& key : keys) tags.RemoveFromKey(key, utils::LuaValue(3));
+				Keep(tags);
+			});
+
+		runner.Measure("Tags/RemoveIndexFromKey until empty/1000 keys", keys.size() * 4,
+			[&prototype]() { return prototype; },
+			[&keys](Tags& tags)
+			{
+				for (const std::string& key : keys)
+				{
+					while (tags.RemoveIndexFromKey(key, 0)) {}
+				}
+				Keep(tags);
+			});
+
+		runner.Measure("Tags/Copy/1000 keys", 1,
+			[&prototype]() { return &prototype; },
+			[](const Tags* tags)
+			{
+				Tags copy = *tags;
+				Keep(copy);
+			});
+	}
+
+	static Register posttags("Tags", TagsBenchmarks);
+}
\ No newline at end of file
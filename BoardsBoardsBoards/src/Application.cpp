@@ -13,11 +13,24 @@
 #include <SDL_syswm.h>
 
 #include "Application.hpp"
+#include "utils/AllocationCounter.hpp"
+#include "utils/FrameProfiler.hpp"
+#include "utils/FrameWake.hpp"
 #include "utils/LuaStack.hpp"
 #include "fonts/fonts.h"
 
 namespace board
 {
+	static Uint32 wake_event_type = 0;
+
+	// Called from any thread through utils::FrameWake, SDL_PushEvent is thread safe
+	static void PushWakeEvent()
+	{
+		SDL_Event event = {};
+		event.type = wake_event_type;
+		SDL_PushEvent(&event);
+	}
+
 	int Application::Start()
 	{
         // - boilerplate code from imgui
@@ -82,6 +95,8 @@ namespace board
             printf("Error: %s\n", SDL_GetError());
             return -1;
         }
+        wake_event_type = SDL_RegisterEvents(1);
+        utils::FrameWake::Install(PushWakeEvent);
 
         // Setup window
         
@@ -107,6 +122,9 @@ namespace board
 
         // Setup Dear ImGui context
         IMGUI_CHECKVERSION();
+        #ifdef BOARD_COUNTING_ALLOCATIONS
+        ImGui::SetAllocatorFunctions(utils::AllocationCounter::CountedMalloc, utils::AllocationCounter::CountedFree);
+        #endif
         ImGui::CreateContext();
         ImGuiIO& io = ImGui::GetIO(); (void)io;
         io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;      
@@ -128,12 +146,30 @@ namespace board
         ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
         // Main loop
+        // Frames that would look like the last one are skipped: the loop sleeps until input arrives, a command is queued or a job finishes
+        const int settle_frames = 3; // ImGui reacts to some input (hovering, opening popups) over the next couple of frames
+        const Uint32 caret_blink_ms = 400; // The text cursor is the only thing ImGui animates on its own
+        const Uint32 idle_timeout_ms = 1000;
+        int frames_to_settle = settle_frames;
+
         bool done = false;
         while (!done)
         {
             SDL_Event event;
-            while (SDL_PollEvent(&event))
+            bool has_event;
+            if (frames_to_settle > 0 || app.NeedsRedraw())
             {
+                has_event = SDL_PollEvent(&event);
+            }
+            else
+            {
+                has_event = SDL_WaitEventTimeout(&event, io.WantTextInput ? caret_blink_ms : idle_timeout_ms);
+            }
+            if (frames_to_settle > 0) frames_to_settle--;
+
+            for (; has_event; has_event = SDL_PollEvent(&event))
+            {
+                frames_to_settle = settle_frames;
                 ImGui_ImplSDL2_ProcessEvent(&event);
                 if (event.type == SDL_QUIT)
                     done = true;
@@ -149,11 +185,15 @@ namespace board
             }
 
             // Start the Dear ImGui frame
+            BOARD_PROFILE_SCOPE(Frame);
             ImGui_ImplDX11_NewFrame();
             ImGui_ImplSDL2_NewFrame();
             ImGui::NewFrame();
 
             app.Render();
+            #ifdef BOARD_PROFILING
+            utils::FrameProfiler::ShowOverlay();
+            #endif
 
             // Rendering
             ImGui::Render();
@@ -161,12 +201,21 @@ namespace board
             g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, NULL);
             g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color_with_alpha);
             ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+            BOARD_PROFILE_END(Frame); // Waiting for vsync is not part of the frame's work
 
             g_pSwapChain->Present(1, 0); // Present with vsync
             //g_pSwapChain->Present(0, 0); // Present without vsync
+
+            #ifdef BOARD_COUNTING_ALLOCATIONS
+            utils::AllocationCounter::EndFrame();
+            #endif
+            #ifdef BOARD_PROFILING
+            utils::FrameProfiler::EndFrame();
+            #endif
         }
 
         // Cleanup
+        utils::FrameWake::Install(nullptr);
         ImGui_ImplDX11_Shutdown();
         ImGui_ImplSDL2_Shutdown();
         ImGui::DestroyContext();
@@ -19,31 +19,29 @@ namespace board
         ImGui::BeginMainMenuBar();
 
         const bool NoTab = !widgets.hasActiveTab();
+        const bool Loading = !NoTab && widgets.getActiveTab().IsLoading(); // Nothing to save or configure yet
 
         if (ImGui::BeginMenu("File"))
         {
             if (ImGui::MenuItem("Open"))
             {
-                const auto open = [this]()
+                const auto open = []()
                 {
                     try
                     {
                         std::vector<std::string> files = FileDialog::OpenMultiple();
+                        std::erase(files, std::string());
                         if (!files.empty())
                         {
-                            for (const std::string& path : files)
-                            {
-                                if (!path.empty())
-                                {
-                                    CommandQueue::addToQueue(CommandQueue::targets::widgetManager, CommandQueue::commands::openFile, path);
-                                }
-                            }
+                            // Sent as one command so the tabs keep the selection order and are named once
+                            CommandQueue::Push(CommandQueue::targets::widgetManager, CommandQueue::OpenFiles{ std::move(files) });
                         }
 
                     }
                     catch (const std::exception& e)
                     {
-                        this->widgets.NewErrorPrompt(e.what());
+                        // Runs on the dialog thread, so the prompt is created by the UI thread through the queue
+                        CommandQueue::CreateErrorWindow(e.what());
                     }
                 };
 
@@ -51,7 +49,7 @@ namespace board
                 t.detach();
                 
             }
-            if (NoTab)
+            if (NoTab || Loading)
             {
                 ImGui::BeginDisabled();
             }
@@ -63,10 +61,9 @@ namespace board
                 if (!path.empty())
                 {
                     auto& container = tab.container;
-                    sol::table t = BoardParser().ToTable(container);
                     try
                     {
-                        LuaStack::TableToFile(t, path);
+                        BoardParser().SavePath(container, path);
                         tab.path = path;
                         tab.current_status = BoardTab::status::fromdisk;
                     }
@@ -77,7 +74,7 @@ namespace board
                 }
                 
             }
-            if (NoTab)
+            if (NoTab || Loading)
             {
                 ImGui::EndDisabled();
             }
@@ -90,16 +87,32 @@ namespace board
             ImGui::EndMenu();
         }
 
-        if (NoTab) ImGui::BeginDisabled();
+        if (NoTab || Loading) ImGui::BeginDisabled();
+        if (ImGui::BeginMenu("Edit"))
+        {
+            const auto& tab = widgets.getActiveTab();
+            if (ImGui::MenuItem("Undo", "Ctrl+Z", false, tab.CanUndo()))
+            {
+                CommandQueue::Push(CommandQueue::targets::currentTab, CommandQueue::Undo{});
+            }
+            if (ImGui::MenuItem("Redo", "Ctrl+Y", false, tab.CanRedo()))
+            {
+                CommandQueue::Push(CommandQueue::targets::currentTab, CommandQueue::Redo{});
+            }
+            ImGui::EndMenu();
+        }
+        if (NoTab || Loading) ImGui::EndDisabled();
+
+        if (NoTab || Loading) ImGui::BeginDisabled();
         if (ImGui::BeginMenu("View"))
         {
             if (ImGui::MenuItem("Board options"))
             {
-                CommandQueue::addToQueue(CommandQueue::targets::currentTab, CommandQueue::commands::openBoardOptions);
+                CommandQueue::Push(CommandQueue::targets::currentTab, CommandQueue::OpenBoardOptions{});
             }
             ImGui::EndMenu();
         }
-        if (NoTab) ImGui::EndDisabled();
+        if (NoTab || Loading) ImGui::EndDisabled();
 
         ImGui::EndMainMenuBar();
 
@@ -116,4 +129,9 @@ namespace board
         ImGui::ShowMetricsWindow();
         #endif
 	}
+
+	bool UI::NeedsRedraw() const
+	{
+        return widgets.NeedsRedraw() || CommandQueue::Pending();
+	}
 }
\ No newline at end of file
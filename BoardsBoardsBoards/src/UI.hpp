@@ -8,6 +8,7 @@ namespace board
 	{
 	public:
 		void Render();
+		bool NeedsRedraw() const; // Asked after Render, false lets the application wait for input instead of drawing the same frame
 	private:
 		WidgetManager widgets;
 	};
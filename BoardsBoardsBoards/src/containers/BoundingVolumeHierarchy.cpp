@@ -0,0 +1,150 @@
+#include <algorithm> // std::nth_element
+#include <cfloat> // FLT_MAX
+
+#include "BoundingVolumeHierarchy.hpp"
+
+namespace board
+{
+	static ImRect EmptyRect()
+	{
+		return ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+	}
+
+	void BoundingVolumeHierarchy::Build(const std::vector<ImRect>& bounds)
+	{
+		Clear();
+		if (bounds.empty()) return;
+
+		item_bounds = bounds;
+		items.resize(bounds.size());
+		leaf_of.resize(bounds.size());
+		for (std::uint32_t i = 0; i < items.size(); i++)
+		{
+			items[i] = i;
+		}
+
+		nodes.reserve(2 * (items.size() / leaf_size + 1));
+		nodes.emplace_back();
+		BuildNode(0, 0, std::uint32_t(items.size()));
+	}
+
+	void BoundingVolumeHierarchy::BuildNode(std::uint32_t node_idx, std::uint32_t first, std::uint32_t count)
+	{
+		ImRect bounds = EmptyRect();
+		ImRect centers = EmptyRect();
+		for (std::uint32_t i = first; i < first + count; i++)
+		{
+			const ImRect& rect = item_bounds[items[i]];
+			bounds.Add(rect);
+			centers.Add(rect.GetCenter());
+		}
+		nodes[node_idx].bounds = bounds;
+
+		if (count <= leaf_size)
+		{
+			nodes[node_idx].first = first;
+			nodes[node_idx].count = count;
+			for (std::uint32_t i = first; i < first + count; i++)
+			{
+				leaf_of[items[i]] = node_idx;
+			}
+			return;
+		}
+
+		// Median split along the axis where the centers are most spread out
+		const bool split_x = centers.GetWidth() >= centers.GetHeight();
+		const std::uint32_t half = count / 2;
+		std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+			[&](std::uint32_t lhs, std::uint32_t rhs)
+			{
+				const ImVec2 l = item_bounds[lhs].GetCenter();
+				const ImVec2 r = item_bounds[rhs].GetCenter();
+				return split_x ? l.x < r.x : l.y < r.y;
+			});
+
+		const std::uint32_t left = std::uint32_t(nodes.size());
+		nodes.emplace_back();
+		nodes.emplace_back();
+		nodes[left].parent = nodes[left + 1].parent = node_idx;
+		nodes[node_idx].first = left;
+		nodes[node_idx].count = 0;
+
+		BuildNode(left, first, half);
+		BuildNode(left + 1, first + half, count - half);
+	}
+
+	void BoundingVolumeHierarchy::UpdateBounds(std::uint32_t node_idx)
+	{
+		Node& node = nodes[node_idx];
+		if (node.count > 0)
+		{
+			node.bounds = EmptyRect();
+			for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				node.bounds.Add(item_bounds[items[i]]);
+			}
+		}
+		else
+		{
+			node.bounds = nodes[node.first].bounds;
+			node.bounds.Add(nodes[node.first + 1].bounds);
+		}
+	}
+
+	void BoundingVolumeHierarchy::Refit(std::size_t item, const ImRect& bounds)
+	{
+		item_bounds.at(item) = bounds;
+		for (std::uint32_t node_idx = leaf_of[item]; node_idx != no_node; node_idx = nodes[node_idx].parent)
+		{
+			UpdateBounds(node_idx);
+		}
+	}
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		nodes.clear();
+		items.clear();
+		item_bounds.clear();
+		leaf_of.clear();
+	}
+
+	template<typename Overlaps>
+	void BoundingVolumeHierarchy::Query(Overlaps overlaps, std::vector<std::size_t>& out) const
+	{
+		if (nodes.empty()) return;
+
+		// Median splits keep the depth under 32 levels for any number of items that fits in 32 bits
+		std::uint32_t stack[64];
+		std::uint32_t stack_size = 0;
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0)
+		{
+			const Node& node = nodes[stack[--stack_size]];
+			if (!overlaps(node.bounds)) continue;
+
+			if (node.count > 0)
+			{
+				for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+				{
+					if (overlaps(item_bounds[items[i]])) out.push_back(items[i]);
+				}
+			}
+			else
+			{
+				stack[stack_size++] = node.first;
+				stack[stack_size++] = node.first + 1;
+			}
+		}
+	}
+
+	void BoundingVolumeHierarchy::QueryPoint(const ImVec2& point, std::vector<std::size_t>& out) const
+	{
+		Query([&point](const ImRect& rect) { return rect.Contains(point); }, out);
+	}
+
+	void BoundingVolumeHierarchy::QueryRect(const ImRect& area, std::vector<std::size_t>& out) const
+	{
+		Query([&area](const ImRect& rect) { return rect.Overlaps(area); }, out);
+	}
+}
\ No newline at end of file
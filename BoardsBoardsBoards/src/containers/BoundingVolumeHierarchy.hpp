@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "imgui_internal.h" // ImRect
+
+namespace board
+{
+	// Static tree of rectangles for point and area queries in logarithmic time.
+	// Items are identified by their index in the vector given to Build. Refit follows an item that moved without
+	// changing the shape of the tree, so queries stay correct but get slower the further items travel; Build again to fix that.
+	class BoundingVolumeHierarchy
+	{
+	public:
+
+		void Build(const std::vector<ImRect>& bounds);
+		void Refit(std::size_t item, const ImRect& bounds);
+		void Clear();
+		std::size_t size() const { return item_bounds.size(); }
+		bool Empty() const { return item_bounds.empty(); }
+
+		// Both queries append to 'out' without clearing it, in no particular order
+		void QueryPoint(const ImVec2& point, std::vector<std::size_t>& out) const;
+		void QueryRect(const ImRect& area, std::vector<std::size_t>& out) const;
+
+	private:
+
+		static constexpr std::uint32_t leaf_size = 4;
+		static constexpr std::uint32_t no_node = UINT32_MAX;
+
+		struct Node
+		{
+			ImRect bounds;
+			std::uint32_t first = 0; // Leaf: first position inside 'items'. Inner node: left child, the right child follows it
+			std::uint32_t count = 0; // Number of items of a leaf, 0 for inner nodes
+			std::uint32_t parent = no_node;
+		};
+
+		std::vector<Node> nodes; // nodes[0] is the root
+		std::vector<std::uint32_t> items; // Item indexes, grouped by leaf
+		std::vector<ImRect> item_bounds;
+		std::vector<std::uint32_t> leaf_of; // Leaf that holds each item
+
+		void BuildNode(std::uint32_t node_idx, std::uint32_t first, std::uint32_t count);
+		void UpdateBounds(std::uint32_t node_idx);
+
+		template<typename Overlaps>
+		void Query(Overlaps overlaps, std::vector<std::size_t>& out) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "EditHistory.hpp"
+
+#include <algorithm> // std::min, std::swap
+
+#include "utils/Error.hpp"
+
+namespace board
+{
+	using utils::EditHistoryError;
+	using utils::PostContainerError;
+
+	PostID EditHistory::CreatePost(PostContainer& container, Post&& post)
+	{
+		const PostID id = container.IDOf(container.Insert(container.end(), std::move(post)));
+		Push(PostRecord{ id, PostID(), 0, std::nullopt }, false);
+		return id;
+	}
+
+	void EditHistory::ErasePost(PostContainer& container, PostID id)
+	{
+		if (!container.Contains(id))
+		{
+			throw PostContainerError("PostContainer: PostID does not refer to a Post in this container.");
+		}
+
+		const bool own_group = !group_open;
+		if (own_group) BeginGroup();
+
+		// Same order as PostContainer::Erase, recorded one by one so undo puts every connection back in its position
+		while (!container.Outgoing(id).empty())
+		{
+			Disconnect(container, id, container.Outgoing(id).back());
+		}
+		while (!container.Incoming(id).empty())
+		{
+			Disconnect(container, container.Incoming(id).back(), id);
+		}
+		Record record = PostRecord{ id, PostID(), 0, std::nullopt };
+		Apply(container, record);
+		Push(std::move(record), false);
+
+		if (own_group) EndGroup();
+	}
+
+	bool EditHistory::Connect(PostContainer& container, PostID from, PostID to)
+	{
+		if (!container.Connect(from, to)) return false;
+		Push(ConnectionRecord{ { from, to } }, false);
+		return true;
+	}
+
+	bool EditHistory::Disconnect(PostContainer& container, PostID from, PostID to)
+	{
+		if (!container.IsConnected(from, to)) return false;
+		Record record = ConnectionRecord{ { from, to } };
+		Apply(container, record);
+		Push(std::move(record), false);
+		return true;
+	}
+
+	void EditHistory::MovePost(PostContainer& container, PostID id, std::pair<float, float> display_pos)
+	{
+		Post& post = container[id];
+		if (Continuing<MoveRecord>(id)) // The record keeps the position from before the first move
+		{
+			post.display_pos = display_pos;
+			return;
+		}
+		Push(MoveRecord{ id, post.display_pos }, true);
+		post.display_pos = display_pos;
+	}
+
+	void EditHistory::SetColor(PostContainer& container, PostID id, const float (&color)[3])
+	{
+		Post& post = container[id];
+		if (!Continuing<ColorRecord>(id))
+		{
+			Push(ColorRecord{ id, { post.color[0], post.color[1], post.color[2] } }, true);
+		}
+		std::copy(std::begin(color), std::end(color), post.color);
+	}
+
+	void EditHistory::SetTag(PostContainer& container, PostID id, const std::string& key, TagEntryList values)
+	{
+		Record record = TagRecord{ id, key, std::move(values) };
+		Apply(container, record);
+		Push(std::move(record), false);
+	}
+
+	void EditHistory::WatchText(const PostContainer& container, PostID id, std::size_t content_idx)
+	{
+		if (text_watch && text_watch->id == id && text_watch->content_idx == content_idx) return;
+		EndContinuousEdit();
+		text_watch.emplace(TextWatch{ id, content_idx, container[id].content[int(content_idx)].AsString() });
+	}
+
+	void EditHistory::TextChanged(const PostContainer& container)
+	{
+		if (!text_watch) return;
+		const std::string& before = text_watch->before;
+		const std::string& after = container[text_watch->id].content[int(text_watch->content_idx)].AsString();
+
+		// Only the span between the common prefix and the common suffix is kept
+		const std::size_t shortest = std::min(before.size(), after.size());
+		std::size_t prefix = 0;
+		while (prefix < shortest && before[prefix] == after[prefix]) prefix++;
+		std::size_t suffix = 0;
+		while (suffix < shortest - prefix && before[before.size() - suffix - 1] == after[after.size() - suffix - 1]) suffix++;
+
+		TextRecord record{ text_watch->id, text_watch->content_idx, prefix,
+			before.substr(prefix, before.size() - prefix - suffix), after.substr(prefix, after.size() - prefix - suffix) };
+
+		// The watched text is the one from before the first change, so the new record replaces the merged one
+		if (TextRecord* merged = Continuing<TextRecord>(text_watch->id); merged && merged->content_idx == record.content_idx)
+		{
+			*merged = std::move(record);
+			Recount(undo_steps.back());
+			EnforceCap();
+			return;
+		}
+		Push(std::move(record), true);
+	}
+
+	void EditHistory::EndContinuousEdit()
+	{
+		continuing = false;
+		text_watch.reset();
+	}
+
+	void EditHistory::BeginGroup()
+	{
+		EndGroup();
+		group_open = true;
+	}
+
+	void EditHistory::EndGroup()
+	{
+		EndContinuousEdit();
+		group_open = false;
+		group_has_step = false;
+	}
+
+	void EditHistory::CancelGroup(PostContainer& container)
+	{
+		const bool has_step = group_open && group_has_step;
+		EndGroup();
+		if (!has_step) return;
+
+		Undo(container);
+		Forget(redo_steps, false);
+	}
+
+	bool EditHistory::Undo(PostContainer& container)
+	{
+		EndGroup();
+		if (undo_steps.empty()) return false;
+
+		Step step = std::move(undo_steps.back());
+		undo_steps.pop_back();
+		try
+		{
+			for (auto record = step.records.rbegin(); record != step.records.rend(); record++)
+			{
+				Apply(container, *record);
+			}
+		}
+		catch (...)
+		{
+			Clear();
+			throw;
+		}
+		redo_steps.push_back(std::move(step));
+		Recount(redo_steps.back()); // Erased Posts moved into or out of the records
+		EnforceCap();
+		return true;
+	}
+
+	bool EditHistory::Redo(PostContainer& container)
+	{
+		EndGroup();
+		if (redo_steps.empty()) return false;
+
+		Step step = std::move(redo_steps.back());
+		redo_steps.pop_back();
+		try
+		{
+			for (Record& record : step.records)
+			{
+				Apply(container, record);
+			}
+		}
+		catch (...)
+		{
+			Clear();
+			throw;
+		}
+		undo_steps.push_back(std::move(step));
+		Recount(undo_steps.back());
+		EnforceCap();
+		return true;
+	}
+
+	void EditHistory::Clear()
+	{
+		EndGroup();
+		undo_steps.clear();
+		redo_steps.clear();
+		memory_usage = 0;
+	}
+
+	void EditHistory::SetMemoryCap(std::size_t bytes)
+	{
+		memory_cap = bytes;
+		EnforceCap();
+	}
+
+	void EditHistory::Apply(PostContainer& container, Record& record)
+	{
+		if (auto post_record = std::get_if<PostRecord>(&record))
+		{
+			if (post_record->post)
+			{
+				container.Restore(post_record->id, std::move(*post_record->post), post_record->dense, post_record->below);
+				post_record->post.reset();
+			}
+			else
+			{
+				auto pos = container.IteratorFromID(post_record->id);
+				post_record->dense = container.PositionOf(post_record->id) - 1;
+				post_record->below = container.Below(post_record->id);
+				post_record->post.emplace(std::move(*pos));
+				container.Erase(pos);
+			}
+		}
+		else if (auto connection_record = std::get_if<ConnectionRecord>(&record))
+		{
+			const PostContainer::PostConnection& connection = connection_record->connection;
+			auto found = container.connection_positions.find(connection);
+			if (found != container.connection_positions.end())
+			{
+				connection_record->position = found->second;
+				container.Disconnect(connection.from, connection.to);
+			}
+			else
+			{
+				container.RestoreConnection(connection, connection_record->position);
+			}
+		}
+		else if (auto move_record = std::get_if<MoveRecord>(&record))
+		{
+			std::swap(container[move_record->id].display_pos, move_record->display_pos);
+		}
+		else if (auto color_record = std::get_if<ColorRecord>(&record))
+		{
+			std::swap(container[color_record->id].color, color_record->color);
+		}
+		else if (auto tag_record = std::get_if<TagRecord>(&record))
+		{
+			Tags& tags = container[tag_record->id].tags;
+			TagEntryList current;
+			if (tags.HasTag(tag_record->key))
+			{
+				current = std::move(tags[tag_record->key]);
+				tags.RemoveKey(tag_record->key);
+			}
+			if (!tag_record->values.Empty())
+			{
+				tags[tag_record->key] = std::move(tag_record->values);
+			}
+			tag_record->values = std::move(current);
+		}
+		else if (auto text_record = std::get_if<TextRecord>(&record))
+		{
+			PostContent& content = container[text_record->id].content[int(text_record->content_idx)];
+			std::string& text = content.AsString();
+			if (text_record->offset > text.size() || text.compare(text_record->offset, text_record->inserted.size(), text_record->inserted) != 0)
+			{
+				throw EditHistoryError("EditHistory: the text of the Post was edited outside of the history.");
+			}
+			text.replace(text_record->offset, text_record->inserted.size(), text_record->removed);
+			content.Edited();
+			std::swap(text_record->removed, text_record->inserted);
+		}
+	}
+
+	void EditHistory::Push(Record&& record, bool continuous)
+	{
+		if (!std::holds_alternative<TextRecord>(record))
+		{
+			text_watch.reset(); // The watched text may no longer be where the next text record starts from
+		}
+		while (!redo_steps.empty())
+		{
+			Forget(redo_steps, false);
+		}
+
+		if (!group_has_step)
+		{
+			undo_steps.emplace_back();
+			group_has_step = group_open;
+		}
+		Step& step = undo_steps.back();
+		step.records.push_back(std::move(record));
+		continuing = continuous;
+
+		Recount(step);
+		EnforceCap();
+	}
+
+	template<typename T>
+	T* EditHistory::Continuing(PostID id)
+	{
+		if (!continuing || undo_steps.empty()) return nullptr;
+		T* record = std::get_if<T>(&undo_steps.back().records.back());
+		if (record == nullptr || record->id != id) return nullptr;
+		return record;
+	}
+
+	void EditHistory::Recount(Step& step)
+	{
+		memory_usage -= step.bytes;
+		step.bytes = sizeof(Step) + step.records.capacity() * sizeof(Record);
+		for (const Record& record : step.records)
+		{
+			step.bytes += RecordBytes(record);
+		}
+		memory_usage += step.bytes;
+	}
+
+	void EditHistory::Forget(std::deque<Step>& steps, bool oldest)
+	{
+		Step& step = (oldest ? steps.front() : steps.back());
+		memory_usage -= step.bytes;
+		if (oldest) steps.pop_front();
+		else steps.pop_back();
+	}
+
+	void EditHistory::EnforceCap()
+	{
+		// Redo steps furthest from the current board go first, then the oldest undo steps
+		while (memory_usage > memory_cap && !redo_steps.empty())
+		{
+			Forget(redo_steps, true);
+		}
+		while (memory_usage > memory_cap && undo_steps.size() > 1)
+		{
+			Forget(undo_steps, true);
+		}
+	}
+
+	static std::size_t TagBytes(const std::string& key, const TagEntryList& values)
+	{
+		return key.capacity() + values.size() * sizeof(LuaValue);
+	}
+
+	std::size_t EditHistory::RecordBytes(const Record& record)
+	{
+		// Heap memory only, the records themselves are counted with the vector holding them
+		std::size_t bytes = 0;
+		if (auto post_record = std::get_if<PostRecord>(&record); post_record && post_record->post)
+		{
+			const Post& post = *post_record->post;
+			bytes += post.content.size() * sizeof(PostContent);
+			for (const PostContent& content : post.content)
+			{
+				if (content.IsString()) bytes += content.AsString().capacity();
+				else bytes += content.AsImageInfo().first.capacity() + content.AsImageInfo().second.capacity();
+			}
+			for (const auto& [key, values] : post.tags)
+			{
+				bytes += TagBytes(key, values);
+			}
+		}
+		else if (auto tag_record = std::get_if<TagRecord>(&record))
+		{
+			bytes += TagBytes(tag_record->key, tag_record->values);
+		}
+		else if (auto text_record = std::get_if<TextRecord>(&record))
+		{
+			bytes += text_record->removed.capacity() + text_record->inserted.capacity();
+		}
+		return bytes;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility> // std::pair
+#include <variant>
+#include <vector>
+
+#include "PostContainer.hpp"
+
+namespace board
+{
+	// Undo and redo for the edits made to a PostContainer, kept as small reversible deltas instead of copies of the board.
+	// Undo gives back the exact earlier board, PostIDs and storage order included, as long as every edit since went through the history.
+	// RaiseToTop is not recorded: the draw order is view state, and a Post that comes back is put above the Post it was above.
+	// Continuous edits (dragging, typing, picking a color) keep merging into one step until EndContinuousEdit.
+	// Once the steps use more memory than the cap, the oldest ones are forgotten; the newest step is always kept.
+	class EditHistory
+	{
+	public:
+		static constexpr std::size_t default_memory_cap = 8 * 1024 * 1024;
+
+		EditHistory(std::size_t memory_cap = default_memory_cap) : memory_cap(memory_cap) {}
+
+		PostID CreatePost(PostContainer& container, Post&& post); // Inserted at the back and on top of the draw order
+		void ErasePost(PostContainer& container, PostID id); // Its connections are removed first and come back with it
+		bool Connect(PostContainer& container, PostID from, PostID to); // Returns what PostContainer::Connect returns, nothing is recorded if false
+		bool Disconnect(PostContainer& container, PostID from, PostID to);
+		void MovePost(PostContainer& container, PostID id, std::pair<float, float> display_pos); // Continuous
+		void SetColor(PostContainer& container, PostID id, const float (&color)[3]); // Continuous
+		void SetTag(PostContainer& container, PostID id, const std::string& key, TagEntryList values); // An empty list removes the key
+
+		// Text widgets edit the string in place, so the text is copied by WatchText right before the widget runs
+		// and TextChanged records the difference right after it. WatchText does nothing if that content is already watched,
+		// TextChanged does nothing if no content is.
+		void WatchText(const PostContainer& container, PostID id, std::size_t content_idx);
+		void TextChanged(const PostContainer& container); // Continuous
+
+		void EndContinuousEdit();
+
+		// Every edit made until EndGroup is undone and redone as one step
+		void BeginGroup();
+		void EndGroup();
+		void CancelGroup(PostContainer& container); // Undoes the edits made since BeginGroup and forgets them
+
+		bool CanUndo() const { return !undo_steps.empty(); }
+		bool CanRedo() const { return !redo_steps.empty(); }
+		// Both return false if there was nothing to apply. If the board no longer matches the history,
+		// they throw whatever PostContainer or EditHistoryError threw and the history is cleared.
+		bool Undo(PostContainer& container);
+		bool Redo(PostContainer& container);
+		void Clear();
+
+		std::size_t MemoryUsage() const { return memory_usage; }
+		std::size_t MemoryCap() const { return memory_cap; }
+		void SetMemoryCap(std::size_t bytes); // Forgets the oldest steps right away if they no longer fit
+
+	private:
+		// A record holds what the board had before it was applied, so applying it again takes the board back
+		struct PostRecord
+		{
+			PostID id;
+			PostID below; // Post it was drawn above when it was taken out
+			std::size_t dense = 0;
+			std::optional<Post> post; // Set while the Post is out of the container
+		};
+		struct ConnectionRecord { PostContainer::PostConnection connection; std::size_t position = 0; };
+		struct MoveRecord { PostID id; std::pair<float, float> display_pos; };
+		struct ColorRecord { PostID id; float color[3]; };
+		struct TagRecord { PostID id; std::string key; TagEntryList values; };
+		struct TextRecord { PostID id; std::size_t content_idx = 0; std::size_t offset = 0; std::string removed; std::string inserted; };
+		using Record = std::variant<PostRecord, ConnectionRecord, MoveRecord, ColorRecord, TagRecord, TextRecord>;
+
+		struct Step
+		{
+			std::vector<Record> records;
+			std::size_t bytes = 0;
+		};
+
+		struct TextWatch
+		{
+			PostID id;
+			std::size_t content_idx = 0;
+			std::string before;
+		};
+
+		void Apply(PostContainer& container, Record& record);
+		void Push(Record&& record, bool continuous);
+		template<typename T>
+		T* Continuing(PostID id);
+		void Recount(Step& step);
+		void Forget(std::deque<Step>& steps, bool oldest);
+		void EnforceCap();
+		static std::size_t RecordBytes(const Record& record);
+
+		std::deque<Step> undo_steps; // Newest at the back
+		std::deque<Step> redo_steps; // Next to redo at the back
+		std::size_t memory_usage = 0;
+		std::size_t memory_cap;
+
+		bool continuing = false; // The last record can still absorb the next edit of the same kind
+		bool group_open = false;
+		bool group_has_step = false;
+		std::optional<TextWatch> text_watch;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <type_traits> // std::conditional_t, std::is_same_v
 #include <vector>
 
 #include "utils/Error.hpp"
@@ -8,26 +9,48 @@ namespace board {
 
 	using utils::LuaVectorError;
 
-	template<typename T>
+	// What at() and operator[] do with an index outside [1, size()], picked at compile time.
+	// Index 0 and negative indexes are never valid, every policy but unchecked throws LuaVectorError for them.
+	enum class LuaVectorAccess
+	{
+		resizable, // Grows to a larger index while auto_resize is set, throws otherwise. The only policy SetAutoResize applies to
+		checked, // Always throws
+		growing, // Always grows, for caches indexed by IDs
+		unchecked // Checked in Debug builds only, for hot loops whose indexes are known to be valid
+	};
+
+	template<typename T, LuaVectorAccess access = LuaVectorAccess::resizable>
 	class LuaVector
-		//TODO: due to the specialization of vector<bool> on the Standard Library, LuaVector<bool> is currently not possible.
 	{
+		// std::vector<bool> packs its elements and cannot hand out a bool&, so bools are kept one per struct
+		struct Bool
+		{
+			bool value = false;
+			Bool(bool value = false) : value(value) {}
+			operator bool&() { return value; }
+			operator const bool&() const { return value; }
+			bool operator==(const Bool& rhs) const { return value == rhs.value; }
+		};
+		using Element = std::conditional_t<std::is_same_v<T, bool>, Bool, T>;
+
 	public:
-		LuaVector(T&& element, bool auto_resize = true) : items{ std::move(element) }, auto_resize(auto_resize) {}
-		LuaVector(const T& element, bool auto_resize = true) : items{ element }, auto_resize(auto_resize) {}
+		// A LuaVector<bool> built from a single bool would be ambiguous with the auto_resize flag, use the std::vector constructor instead
+		LuaVector(T&& element, bool auto_resize = true) requires (!std::is_same_v<T, bool>) : items{ std::move(element) }, auto_resize(auto_resize) {}
+		LuaVector(const T& element, bool auto_resize = true) requires (!std::is_same_v<T, bool>) : items{ element }, auto_resize(auto_resize) {}
 
-		LuaVector(const std::vector<T>& elements, bool auto_resize = true) : items(elements), auto_resize(auto_resize) {}
+		LuaVector(const std::vector<T>& elements, bool auto_resize = true) : items(elements.begin(), elements.end()), auto_resize(auto_resize) {}
 
 		LuaVector(bool auto_resize = true) : auto_resize(auto_resize) {}
 
 
-		bool operator==(const LuaVector<T>& rhs) const
+		bool operator==(const LuaVector& rhs) const
 		{
 			return items == rhs.items;
 		}
 
 
-		using iterator = std::vector<T>::iterator;
+		// Iterators of a LuaVector<bool> point to a struct that converts to bool&
+		using iterator = std::vector<Element>::iterator;
 		iterator IteratorFromIndex(std::size_t pos)
 		{
 			if (pos == size() + 1) return end();
@@ -41,25 +64,16 @@ namespace board {
 		T& operator[](int idx) { return at(idx); }
 		T& front() { return items.front(); }
 		T& back() { return items.back(); }
-		void SetAutoResize(bool resize) { auto_resize = resize; }
+		void SetAutoResize(bool resize) requires (access == LuaVectorAccess::resizable) { auto_resize = resize; }
 		T& at(int count)
 		{
-			try
-			{
-				return items.at(offset_idx(count));
-			}
-			catch (const std::out_of_range&)
+			if (checks && (count <= 0 || std::size_t(count) > items.size()))
 			{
-				if (auto_resize && count > 0)
-				{
-					items.resize(count);
-					return items.at(offset_idx(count));
-				}
-				else
-				{
-					throw LuaVectorError("LuaVector does not have index " + std::to_string(count) + ".");
-				}
+				const bool grows = (access == LuaVectorAccess::growing || (access == LuaVectorAccess::resizable && auto_resize));
+				if (!grows || count <= 0) OutOfRange(count);
+				items.resize(count);
 			}
+			return items[offset_idx(count)];
 		}
 
 		iterator Insert(iterator pos, T&& value)
@@ -87,7 +101,7 @@ namespace board {
 		
 
 
-		using const_iterator = std::vector<T>::const_iterator;
+		using const_iterator = std::vector<Element>::const_iterator;
 		const_iterator begin() const { return items.cbegin(); } 
 		const_iterator end() const { return items.cend(); }		
 
@@ -103,16 +117,14 @@ namespace board {
 		const T& operator[](int idx) const { return at(idx); }		
 		const T& front() const { return items.front(); }		
 		const T& back() const { return items.back(); }
+		// Never grows, a const LuaVector throws for indexes past the end unless it is unchecked
 		const T& at(int count) const
 		{
-			try
+			if (checks && (count <= 0 || std::size_t(count) > items.size()))
 			{
-				return items.at(offset_idx(count));
-			}
-			catch (const std::out_of_range&)
-			{
-				throw LuaVectorError("LuaVector does not have index " + std::to_string(count) + ".");
+				OutOfRange(count);
 			}
+			return items[offset_idx(count)];
 		}
 
 		std::size_t size() const { return items.size(); }
@@ -136,13 +148,29 @@ namespace board {
 		{
 			items.resize(count);
 		}
+		void Reserve(std::size_t count)
+		{
+			items.reserve(count);
+		}
 		void ChangeAllValues(const T& value)
 		{
 			items.assign(items.size(), value);
 		}
 	private:
-		std::vector<T> items;
+		#ifdef BOARD_DEBUG
+		static constexpr bool checks = true;
+		#else
+		static constexpr bool checks = (access != LuaVectorAccess::unchecked);
+		#endif
+
+		std::vector<Element> items;
 		bool auto_resize;
 		inline int offset_idx(int idx) const { return idx - 1; }
+
+		// Kept out of at(), so the path that does not throw stays small enough to be inlined
+		[[noreturn]] static void OutOfRange(int count)
+		{
+			throw LuaVectorError("LuaVector does not have index " + std::to_string(count) + ".");
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace board
+{
+	// Unbounded lock-free queue for many producer threads and a single consumer thread.
+	// Push may be called from any thread, TryPop only from the one consuming thread.
+	// Items pushed by the same thread come out in the order they were pushed.
+	template<typename T>
+	class MPSCQueue
+	{
+	public:
+		MPSCQueue() : head(&stub), tail(&stub) {}
+		~MPSCQueue()
+		{
+			while (TryPop()) {}
+		}
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+		void Push(T value)
+		{
+			PushNode(new Node(std::move(value)));
+		}
+
+		// Consumer thread only. An item whose producer is still linking it may not be seen yet
+		bool Empty() const
+		{
+			return tail == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+		}
+
+		// Returns nothing when the queue is empty, or when the only item left is still being linked by its producer
+		std::optional<T> TryPop()
+		{
+			Node* last = tail;
+			Node* next = last->next.load(std::memory_order_acquire);
+			if (last == &stub)
+			{
+				if (!next) return std::nullopt;
+				tail = next;
+				last = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+			if (!next)
+			{
+				if (last != head.load(std::memory_order_acquire)) return std::nullopt;
+				// The stub goes back in behind the last item so the item can be handed out
+				PushNode(&stub);
+				next = last->next.load(std::memory_order_acquire);
+				if (!next) return std::nullopt;
+			}
+			tail = next;
+			std::optional<T> value = std::move(last->value);
+			delete last;
+			return value;
+		}
+
+	private:
+		struct Node
+		{
+			Node() = default;
+			Node(T value) : value(std::move(value)) {}
+			std::atomic<Node*> next = nullptr;
+			std::optional<T> value; // Empty only for the stub
+		};
+
+		void PushNode(Node* node)
+		{
+			node->next.store(nullptr, std::memory_order_relaxed);
+			Node* previous = head.exchange(node, std::memory_order_acq_rel);
+			previous->next.store(node, std::memory_order_release);
+		}
+
+		Node stub;
+		std::atomic<Node*> head; // Last pushed node, written by producers
+		Node* tail; // Next node to pop, only touched by the consumer
+	};
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <sstream>
+#include <algorithm> // std::rotate, std::find
+#include <unordered_set>
 
 #include "PostContainer.hpp"
 #include "utils/Error.hpp"
@@ -7,7 +9,7 @@
 namespace board
 {
 	using utils::PostContainerError;
-		
+
 	PostContainer::iterator PostContainer::IteratorFromIndex(std::size_t idx)
 	{
 		try
@@ -20,7 +22,7 @@ namespace board
 			error << "PostContainer: " << err.what();
 			throw PostContainerError(error.str());
 		}
-		
+
 	}
 
 	PostContainer::const_iterator PostContainer::IteratorFromIndex(std::size_t idx) const
@@ -36,27 +38,68 @@ namespace board
 			throw PostContainerError(error.str());
 		}
 	}
-	
-	PostContainer::iterator PostContainer::MoveToLastPosition(iterator pos)
+
+	PostContainer::iterator PostContainer::IteratorFromID(PostID id)
 	{
-		if (pos == end())
+		if (!Contains(id))
 		{
-			throw PostContainerError("PostContainer: cannot operate on end iterator\n;");
+			throw PostContainerError("PostContainer: PostID does not refer to a Post in this container.");
 		}
+		return std::next(begin(), slots[id.slot].dense);
+	}
+
+	PostContainer::const_iterator PostContainer::IteratorFromID(PostID id) const
+	{
+		if (!Contains(id))
+		{
+			throw PostContainerError("PostContainer: PostID does not refer to a Post in this container.");
+		}
+		return std::next(begin(), slots[id.slot].dense);
+	}
+
+	bool PostContainer::Contains(PostID id) const
+	{
+		if (id.IsNull() || id.slot >= slots.size()) return false;
+		const Slot& slot = slots[id.slot];
+		return slot.generation == id.generation && slot.dense < dense_ids.size() && dense_ids[slot.dense] == id;
+	}
 
-		Post copy = *pos;
-		std::size_t old_idx = copy.GetIdx();
+	PostID PostContainer::IDAt(std::size_t pos) const
+	{
+		if (pos == 0 || pos > size())
+		{
+			throw PostContainerError("PostContainer: there is no Post at index " + std::to_string(pos) + ".");
+		}
+		return dense_ids[pos - 1];
+	}
 
-		auto new_pos = Insert(end(), std::move(copy));
+	PostID PostContainer::IDOf(const_iterator pos) const
+	{
+		if (pos == end())
+		{
+			throw PostContainerError("PostContainer: cannot operate on end iterator");
+		}
+		return dense_ids[pos - begin()];
+	}
 
-		std::size_t new_idx = new_pos->GetIdx();
+	std::size_t PostContainer::PositionOf(PostID id) const
+	{
+		if (!Contains(id)) return 0;
+		return slots[id.slot].dense + 1;
+	}
 
-		std::unordered_map<std::size_t, std::size_t> change;
-		change[old_idx] = new_idx;
+	PostContainer::iterator PostContainer::MoveToLastPosition(iterator pos)
+	{
+		if (pos == end())
+		{
+			throw PostContainerError("PostContainer: cannot operate on end iterator\n;");
+		}
 
-		ReconnectNodes(change);
+		std::size_t dense = pos - begin();
 
-		Erase(IteratorFromIndex(old_idx));
+		std::rotate(pos, std::next(pos), end());
+		std::rotate(dense_ids.begin() + dense, dense_ids.begin() + dense + 1, dense_ids.end());
+		UpdateSlots(dense, size());
 
 		return (posts.end() - 1);
 
@@ -67,78 +110,305 @@ namespace board
 		return MoveToLastPosition(IteratorFromIndex(pos));
 	}
 
+	PostID PostContainer::AllocateSlot()
+	{
+		std::uint32_t slot_idx;
+		if (!free_slots.empty())
+		{
+			slot_idx = free_slots.back();
+			free_slots.pop_back();
+			slots[slot_idx].free_index = no_slot;
+		}
+		else
+		{
+			slot_idx = std::uint32_t(slots.size());
+			slots.emplace_back();
+			adjacency.emplace_back();
+		}
+		return PostID{ slot_idx, slots[slot_idx].generation };
+	}
+
+	void PostContainer::FreeSlot(PostID id)
+	{
+		// Continues from the highest generation, not the current one, so an ID handed out before an undo is never handed out again
+		Slot& slot = slots[id.slot];
+		slot.max_generation++;
+		if (slot.max_generation == 0) slot.max_generation = 1; // 0 is reserved for null IDs
+		slot.generation = slot.max_generation;
+		slot.free_index = std::uint32_t(free_slots.size());
+		free_slots.push_back(id.slot);
+	}
+
+	void PostContainer::TakeFreeSlot(std::uint32_t slot_idx)
+	{
+		const std::uint32_t free_index = slots[slot_idx].free_index;
+		const std::uint32_t moved = free_slots.back();
+		free_slots[free_index] = moved;
+		slots[moved].free_index = free_index;
+		free_slots.pop_back();
+		slots[slot_idx].free_index = no_slot;
+	}
+
+	void PostContainer::UpdateSlots(std::size_t first_dense, std::size_t last_dense)
+	{
+		for (std::size_t i = first_dense; i < last_dense && i < dense_ids.size(); i++)
+		{
+			slots[dense_ids[i].slot].dense = std::uint32_t(i);
+		}
+	}
+
+	void PostContainer::LinkOnTop(std::uint32_t slot_idx)
+	{
+		Slot& slot = slots[slot_idx];
+		slot.below = top_slot;
+		slot.above = no_slot;
+		slot.stacking = next_stacking++;
+		if (top_slot != no_slot)
+		{
+			slots[top_slot].above = slot_idx;
+		}
+		else
+		{
+			bottom_slot = slot_idx;
+		}
+		top_slot = slot_idx;
+	}
+
+	void PostContainer::Unlink(std::uint32_t slot_idx)
+	{
+		Slot& slot = slots[slot_idx];
+		if (slot.below != no_slot) slots[slot.below].above = slot.above;
+		else bottom_slot = slot.above;
+
+		if (slot.above != no_slot) slots[slot.above].below = slot.below;
+		else top_slot = slot.below;
+
+		slot.below = slot.above = no_slot;
+	}
+
+	void PostContainer::LinkAbove(std::uint32_t slot_idx, std::uint32_t below_idx)
+	{
+		if (below_idx == top_slot)
+		{
+			LinkOnTop(slot_idx);
+			return;
+		}
+		Slot& slot = slots[slot_idx];
+		slot.below = below_idx;
+		slot.above = (below_idx == no_slot ? bottom_slot : slots[below_idx].above);
+		slots[slot.above].below = slot_idx;
+		if (below_idx != no_slot) slots[below_idx].above = slot_idx;
+		else bottom_slot = slot_idx;
+
+		const std::uint64_t floor = (below_idx == no_slot ? 0 : slots[below_idx].stacking);
+		if (slots[slot.above].stacking - floor > 1)
+		{
+			slot.stacking = floor + 1;
+		}
+		else // No stacking value left between both neighbours
+		{
+			RenumberStacking();
+		}
+	}
+
+	void PostContainer::RenumberStacking()
+	{
+		next_stacking = 1;
+		for (std::uint32_t slot_idx = bottom_slot; slot_idx != no_slot; slot_idx = slots[slot_idx].above)
+		{
+			slots[slot_idx].stacking = next_stacking++;
+		}
+	}
+
+	PostID PostContainer::IDFromSlot(std::uint32_t slot_idx) const
+	{
+		if (slot_idx == no_slot) return PostID();
+		return PostID{ slot_idx, slots[slot_idx].generation };
+	}
+
+	void PostContainer::RaiseToTop(PostID id)
+	{
+		if (!Contains(id))
+		{
+			throw PostContainerError("PostContainer: PostID does not refer to a Post in this container.");
+		}
+		if (top_slot == id.slot) return;
+		Unlink(id.slot);
+		LinkOnTop(id.slot);
+	}
+
+	PostID PostContainer::Bottom() const
+	{
+		return IDFromSlot(bottom_slot);
+	}
+
+	PostID PostContainer::Top() const
+	{
+		return IDFromSlot(top_slot);
+	}
+
+	PostID PostContainer::Above(PostID id) const
+	{
+		if (!Contains(id)) return PostID();
+		return IDFromSlot(slots[id.slot].above);
+	}
+
+	PostID PostContainer::Below(PostID id) const
+	{
+		if (!Contains(id)) return PostID();
+		return IDFromSlot(slots[id.slot].below);
+	}
+
+	bool PostContainer::IsAbove(PostID id, PostID other) const
+	{
+		if (!Contains(id) || !Contains(other)) return false;
+		return slots[id.slot].stacking > slots[other.slot].stacking;
+	}
+
+	std::vector<PostID> PostContainer::GetDrawOrder() const
+	{
+		std::vector<PostID> order;
+		order.reserve(size());
+		for (PostID id = Bottom(); !id.IsNull(); id = Above(id))
+		{
+			order.push_back(id);
+		}
+		return order;
+	}
 
-	void PostContainer::PropagateIndexShift(iterator start, int offset, std::size_t removed_node_idx)
+	// Searching from the back keeps RemoveConnectionsOf, which drains lists from the back, linear in the Post's degree
+	static void RemoveFromList(std::vector<PostID>& list, PostID id)
 	{
-		PropagateIndexShift(start, end(), offset, removed_node_idx);
+		auto it = std::find(list.rbegin(), list.rend(), id);
+		if (it == list.rend()) return;
+		*it = list.back();
+		list.pop_back();
 	}
 
-	void PostContainer::PropagateIndexShift(iterator start, iterator end, int offset, std::size_t removed_node_idx)
+	void PostContainer::RemoveConnectionsOf(PostID id)
 	{
-		std::unordered_map<std::size_t, std::size_t> changes;
-		if (removed_node_idx != 0)
+		Adjacency& edges = adjacency[id.slot];
+		while (!edges.outgoing.empty())
 		{
-			changes[removed_node_idx] = 0;
+			Disconnect(id, edges.outgoing.back());
 		}
-		while (start != end && start != this->end())
+		while (!edges.incoming.empty())
 		{
-			Post& post = *(start);
-			int old_idx = post.GetIdx();
-			post.IndexShift(offset);
-			int new_idx = post.GetIdx();
-			changes[old_idx] = new_idx;
+			Disconnect(edges.incoming.back(), id);
+		}
+	}
 
-			start = std::next(start);
+	bool PostContainer::Connect(PostID from, PostID to)
+	{
+		if (!Contains(from) || !Contains(to))
+		{
+			throw PostContainerError("PostContainer: cannot connect a PostID that does not refer to a Post in this container.");
 		}
-		ReconnectNodes(changes);
+		if (from == to) return false;
+
+		PostConnection connection(from, to);
+		if (connection_positions.contains(connection)) return false;
+
+		connections.PushBack(connection);
+		connection_positions.emplace(connection, connections.size());
+		adjacency[from.slot].outgoing.push_back(to);
+		adjacency[to.slot].incoming.push_back(from);
+
+		return true;
 	}
 
-	void PostContainer::ReconnectNodes(std::unordered_map<std::size_t, std::size_t>& index_changes)
+	bool PostContainer::Disconnect(PostID from, PostID to)
 	{
-		std::vector<LuaVector<PostConnection>::iterator> to_delete;
+		auto found = connection_positions.find(PostConnection(from, to));
+		if (found == connection_positions.end()) return false;
 
-		for (auto it = connections.begin(); it != connections.end(); it++)
+		const std::size_t pos = found->second;
+		const std::size_t last = connections.size();
+		connection_positions.erase(found);
+
+		if (pos != last) // The last connection takes the place of the removed one
 		{
-			auto& connection = *it;
-			auto& from = connection.from;
-			auto& to = connection.to;
+			connections[pos] = connections[last];
+			connection_positions[connections[pos]] = pos;
+		}
+		connections.PopBack();
 
-			auto CheckIdx = [&index_changes, &to_delete, &it](std::size_t& idx) -> void
-			{
-				if (index_changes.contains(idx))
-				{
-					auto new_idx = index_changes[idx];
-					if (new_idx == 0)
-					{
-						to_delete.emplace_back(it);
-						return;
-					}
-					idx = new_idx;
+		RemoveFromList(adjacency[from.slot].outgoing, to);
+		RemoveFromList(adjacency[to.slot].incoming, from);
 
-				}
-			};
+		return true;
+	}
 
-			CheckIdx(from);
-			CheckIdx(to);
+	void PostContainer::RestoreConnection(const PostConnection& connection, std::size_t position)
+	{
+		if (!Contains(connection.from) || !Contains(connection.to))
+		{
+			throw PostContainerError("PostContainer: cannot connect a PostID that does not refer to a Post in this container.");
+		}
+		if (connection.from == connection.to || connection_positions.contains(connection))
+		{
+			throw PostContainerError("PostContainer: cannot restore a connection that already exists.");
+		}
+		if (position == 0 || position > connections.size() + 1)
+		{
+			throw PostContainerError("PostContainer: cannot restore a connection at position " + std::to_string(position) + ".");
+		}
+
+		connections.PushBack(connection);
+		const std::size_t last = connections.size();
+		if (position != last) // Disconnect moved the last connection into this position, it goes back to the end
+		{
+			connections[int(last)] = connections[int(position)];
+			connection_positions[connections[int(last)]] = last;
+			connections[int(position)] = connection;
+		}
+		connection_positions.emplace(connection, position);
+		adjacency[connection.from.slot].outgoing.push_back(connection.to);
+		adjacency[connection.to.slot].incoming.push_back(connection.from);
+	}
+
+	bool PostContainer::IsConnected(PostID from, PostID to) const
+	{
+		return connection_positions.contains(PostConnection(from, to));
+	}
+
+	const std::vector<PostID>& PostContainer::Outgoing(PostID id) const
+	{
+		if (!Contains(id))
+		{
+			throw PostContainerError("PostContainer: PostID does not refer to a Post in this container.");
 		}
+		return adjacency[id.slot].outgoing;
+	}
 
-		for (int i = to_delete.size() - 1; i >= 0; i--)
+	const std::vector<PostID>& PostContainer::Incoming(PostID id) const
+	{
+		if (!Contains(id))
 		{
-			connections.Erase(to_delete[i]);
+			throw PostContainerError("PostContainer: PostID does not refer to a Post in this container.");
 		}
+		return adjacency[id.slot].incoming;
 	}
 
 	bool PostContainer::operator== (const PostContainer& rhs) const
 	{
 		if (size() != rhs.size()) return false;
 		if (board_options != rhs.board_options) return false;
-		if (connections != rhs.connections) return false;
+		if (connections.size() != rhs.connections.size()) return false;
 		for (std::size_t i = 1; i <= size(); i++)
 		{
 			const Post& p1 = posts[i];
 			const Post& p2 = rhs[i];
 			if (p1 != p2) return false;
 		}
+		// IDs are local to each container, so connections are compared by the positions they link
+		for (std::size_t i = 1; i <= connections.size(); i++)
+		{
+			const PostConnection& c1 = connections[i];
+			const PostConnection& c2 = rhs.connections[i];
+			if (PositionOf(c1.from) != rhs.PositionOf(c2.from)) return false;
+			if (PositionOf(c1.to) != rhs.PositionOf(c2.to)) return false;
+		}
 		return true;
 	}
 
@@ -150,27 +420,27 @@ namespace board
 
 	PostContainer::iterator PostContainer::Insert(iterator pos, Post&& post)
 	{
+		std::size_t dense = pos - begin();
+		PostID id = AllocateSlot();
+
 		PostContainer::iterator it = posts.Insert(pos, std::move(post));
-		Post& new_post = *(it);
-		if (it == begin())
-		{
-			new_post.SetIdx(1);
-		}
-		else if (std::next(it) == end())
-		{
-			new_post.SetIdx(size());
-		}
-		else
-		{
-			new_post.SetIdx(it - begin() + 1);
-		}
+		dense_ids.insert(dense_ids.begin() + dense, id);
 
-		PropagateIndexShift(std::next(it), +1);
+		UpdateSlots(dense, size()); // Only touches the new Post when inserting at the back
+		LinkOnTop(id.slot);
 
 		return it;
 
 	}
 
+	void PostContainer::InsertBackWithID(Post&& post, PostID id)
+	{
+		posts.PushBack(std::move(post));
+		dense_ids.push_back(id);
+		slots[id.slot].dense = std::uint32_t(dense_ids.size() - 1);
+		LinkOnTop(id.slot);
+	}
+
 	PostContainer::iterator PostContainer::CreatePostBack(std::string&& content)
 	{
 		return CreatePost(end(), std::move(content));
@@ -199,12 +469,56 @@ namespace board
 		{
 			throw PostContainerError("Cannot operate on end iterator");
 		}
-		std::size_t removed_node_idx = pos->GetIdx();
-		iterator ret = posts.Erase(pos);
+		std::size_t dense = pos - begin();
+		std::size_t last = size() - 1;
+		PostID removed = dense_ids[dense];
+
+		RemoveConnectionsOf(removed);
+
+		if (dense != last)
+		{
+			*pos = std::move(posts.back());
+			dense_ids[dense] = dense_ids[last];
+			slots[dense_ids[dense].slot].dense = std::uint32_t(dense);
+		}
+		posts.PopBack();
+		dense_ids.pop_back();
+
+		Unlink(removed.slot);
+		FreeSlot(removed);
+
+		return std::next(begin(), dense);
+	}
+
+	void PostContainer::Restore(PostID id, Post&& post, std::size_t dense, PostID below)
+	{
+		if (id.IsNull() || id.slot >= slots.size() || slots[id.slot].free_index == no_slot)
+		{
+			throw PostContainerError("PostContainer: cannot restore a Post into a slot that is in use.");
+		}
+		if (dense > size())
+		{
+			throw PostContainerError("PostContainer: cannot restore a Post at index " + std::to_string(dense + 1) + ".");
+		}
+		if (!below.IsNull() && !Contains(below))
+		{
+			throw PostContainerError("PostContainer: cannot restore a Post above a PostID that does not refer to a Post in this container.");
+		}
 
-		PropagateIndexShift(ret, -1, removed_node_idx);
+		TakeFreeSlot(id.slot);
+		slots[id.slot].generation = id.generation;
 
-		return ret;
+		posts.PushBack(std::move(post));
+		dense_ids.push_back(id);
+		const std::size_t last = size() - 1;
+		if (dense != last) // Erase moved the last Post into this position, it goes back to the end
+		{
+			std::swap(posts[int(dense) + 1], posts[int(last) + 1]);
+			std::swap(dense_ids[dense], dense_ids[last]);
+			UpdateSlots(last, last + 1);
+		}
+		UpdateSlots(dense, dense + 1);
+		LinkAbove(id.slot, below.IsNull() ? no_slot : below.slot);
 	}
 
 	void PostContainer::PopBack()
@@ -212,9 +526,169 @@ namespace board
 		if (Empty()) return;
 		Erase(end() - 1);
 	}
+
 	void PostContainer::Resize(int count)
 	{
-		posts.Resize(count);
+		if (count < 0)
+		{
+			throw PostContainerError("PostContainer: cannot resize to " + std::to_string(count) + ".");
+		}
+		while (size() > std::size_t(count))
+		{
+			PopBack();
+		}
+		while (size() < std::size_t(count))
+		{
+			CreatePostBack();
+		}
+	}
+
+	void PostContainer::Clear()
+	{
+		for (const PostID& id : dense_ids)
+		{
+			adjacency[id.slot] = Adjacency();
+			Unlink(id.slot);
+			FreeSlot(id);
+		}
+		posts.Clear();
+		dense_ids.clear();
+		connections.Clear();
+		connection_positions.clear();
+	}
+
+	PostContainer::Batch::~Batch()
+	{
+		Rollback();
+	}
+
+	PostID PostContainer::Batch::InsertBack(const Post& post)
+	{
+		Post to_move = post;
+		return InsertBack(std::move(to_move));
+	}
+
+	PostID PostContainer::Batch::InsertBack(Post&& post)
+	{
+		PostID id = container.AllocateSlot();
+		edits.push_back(InsertEdit{ id, std::move(post) });
+		return id;
+	}
+
+	void PostContainer::Batch::Erase(PostID id)
+	{
+		edits.push_back(EraseEdit{ id });
+	}
+
+	void PostContainer::Batch::RaiseToTop(PostID id)
+	{
+		edits.push_back(RaiseEdit{ id });
+	}
+
+	void PostContainer::Batch::Connect(PostID from, PostID to)
+	{
+		edits.push_back(ConnectEdit{ from, to });
+	}
+
+	void PostContainer::Batch::Disconnect(PostID from, PostID to)
+	{
+		edits.push_back(DisconnectEdit{ from, to });
+	}
+
+	void PostContainer::Batch::Validate() const
+	{
+		std::unordered_set<PostID> inserted;
+		std::unordered_set<PostID> erased;
+		auto exists = [&](PostID id)
+		{
+			if (erased.contains(id)) return false;
+			return inserted.contains(id) || container.Contains(id);
+		};
+
+		for (const Edit& edit : edits)
+		{
+			if (auto insert = std::get_if<InsertEdit>(&edit))
+			{
+				inserted.insert(insert->id);
+			}
+			else if (auto erase = std::get_if<EraseEdit>(&edit))
+			{
+				if (!exists(erase->id))
+				{
+					throw PostContainerError("PostContainer: batch erases a PostID that does not refer to a Post in this container.");
+				}
+				erased.insert(erase->id);
+			}
+			else if (auto raise = std::get_if<RaiseEdit>(&edit))
+			{
+				if (!exists(raise->id))
+				{
+					throw PostContainerError("PostContainer: batch raises a PostID that does not refer to a Post in this container.");
+				}
+			}
+			else if (auto connect = std::get_if<ConnectEdit>(&edit))
+			{
+				if (!exists(connect->from) || !exists(connect->to))
+				{
+					throw PostContainerError("PostContainer: batch connects a PostID that does not refer to a Post in this container.");
+				}
+			}
+		}
+	}
+
+	void PostContainer::Batch::Commit()
+	{
+		Validate();
+
+		std::size_t inserts = 0;
+		std::size_t connects = 0;
+		for (const Edit& edit : edits)
+		{
+			if (std::holds_alternative<InsertEdit>(edit)) inserts++;
+			else if (std::holds_alternative<ConnectEdit>(edit)) connects++;
+		}
+		// Grow every container once for the whole batch instead of once per edit
+		container.posts.Reserve(container.size() + inserts);
+		container.dense_ids.reserve(container.size() + inserts);
+		container.connections.Reserve(container.connections.size() + connects);
+		container.connection_positions.reserve(container.connections.size() + connects);
+
+		for (Edit& edit : edits)
+		{
+			if (auto insert = std::get_if<InsertEdit>(&edit))
+			{
+				container.InsertBackWithID(std::move(insert->post), insert->id);
+			}
+			else if (auto erase = std::get_if<EraseEdit>(&edit))
+			{
+				container.Erase(container.IteratorFromID(erase->id));
+			}
+			else if (auto raise = std::get_if<RaiseEdit>(&edit))
+			{
+				container.RaiseToTop(raise->id);
+			}
+			else if (auto connect = std::get_if<ConnectEdit>(&edit))
+			{
+				container.Connect(connect->from, connect->to);
+			}
+			else if (auto disconnect = std::get_if<DisconnectEdit>(&edit))
+			{
+				container.Disconnect(disconnect->from, disconnect->to);
+			}
+		}
+		edits.clear();
+	}
+
+	void PostContainer::Batch::Rollback()
+	{
+		for (const Edit& edit : edits)
+		{
+			if (auto insert = std::get_if<InsertEdit>(&edit))
+			{
+				container.FreeSlot(insert->id);
+			}
+		}
+		edits.clear();
 	}
 
 }
\ No newline at end of file
@@ -1,14 +1,17 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
 #include "LuaVector.hpp"
+#include "PostID.hpp"
 #include "renderables/posts/Post.hpp"
 #include "utils/BoardColors.hpp"
 
 using std::string;
-using std::unordered_map;
 using utils::BoardColors;
 
 namespace board
@@ -16,33 +19,53 @@ namespace board
 	class PostContainer
 	{
 	public:
-		
-		using iterator = LuaVector<Post>::iterator;				
+
+		using iterator = LuaVector<Post, LuaVectorAccess::checked>::iterator;
 		iterator begin() { return posts.begin(); }
 		iterator end() { return posts.end(); }
 		iterator IteratorFromIndex(std::size_t pos);
+		iterator IteratorFromID(PostID id);
 		iterator Insert(iterator pos, const Post& post);
 		iterator Insert(iterator pos, Post&& post);
-		iterator CreatePost(iterator pos, const std::string& content); 
-		iterator CreatePost(iterator pos, std::string&& content = ""); 	
+		iterator CreatePost(iterator pos, const std::string& content);
+		iterator CreatePost(iterator pos, std::string&& content = "");
 		iterator CreatePostBack(const std::string& content);
 		iterator CreatePostBack(std::string&& content = "");
-		iterator Erase(iterator pos);
+		iterator Erase(iterator pos); // Moves the last Post into the erased position; every PostID stays valid
 		iterator MoveToLastPosition(iterator pos);
 		iterator MoveToLastPosition(std::size_t pos);
 
 
-		using const_iterator = LuaVector<Post>::const_iterator;
+		using const_iterator = LuaVector<Post, LuaVectorAccess::checked>::const_iterator;
 		const_iterator begin() const { return posts.begin(); }
 		const_iterator end() const { return posts.end(); }
 		const_iterator IteratorFromIndex(std::size_t pos) const;
+		const_iterator IteratorFromID(PostID id) const;
 		const Post& operator[](int count) const { return posts.at(count); };
+		const Post& operator[](PostID id) const { return *IteratorFromID(id); }
 		std::size_t size() const { return posts.size(); }
 
-		
+		bool Contains(PostID id) const;
+		PostID IDAt(std::size_t pos) const; // Throws if there is no Post at pos
+		PostID IDOf(const_iterator pos) const;
+		std::size_t PositionOf(PostID id) const; // Returns 0 if id does not refer to a Post in this container
+
+		// Draw order is kept apart from storage order: new Posts enter on top and
+		// RaiseToTop never moves a Post inside the container.
+		// Walk it with: for (PostID id = Bottom(); !id.IsNull(); id = Above(id))
+		void RaiseToTop(PostID id);
+		PostID Bottom() const;
+		PostID Top() const;
+		PostID Above(PostID id) const; // Returns a null PostID if id is on top
+		PostID Below(PostID id) const; // Returns a null PostID if id is at the bottom
+		bool IsAbove(PostID id, PostID other) const; // True if id is drawn after other
+		std::vector<PostID> GetDrawOrder() const;
+
+
 		bool operator==(const PostContainer& rhs) const;
 		Post& operator[](int count) { return posts.at(count); };
-		void Clear() { posts.Clear(); }
+		Post& operator[](PostID id) { return *IteratorFromID(id); }
+		void Clear();
 		void PopBack();
 		void Resize(int count);
 		bool Empty() const { return posts.Empty(); }
@@ -62,9 +85,9 @@ namespace board
 
 		struct PostConnection
 		{
-			PostConnection(std::size_t from = 0, std::size_t to = 0) : from(from), to(to) {}
-			std::size_t from;
-			std::size_t to;
+			PostConnection(PostID from = PostID(), PostID to = PostID()) : from(from), to(to) {}
+			PostID from;
+			PostID to;
 
 			bool operator==(const PostConnection& rhs) const
 			{
@@ -72,14 +95,113 @@ namespace board
 			}
 		};
 
-		LuaVector<PostConnection> connections = LuaVector<PostConnection>(false);
+		struct ConnectionHash
+		{
+			std::size_t operator()(const PostConnection& connection) const noexcept
+			{
+				const std::size_t h1 = std::hash<PostID>()(connection.from);
+				const std::size_t h2 = std::hash<PostID>()(connection.to);
+				return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+			}
+		};
+
+		// Returns false if the connection already exists or would link a Post to itself
+		// Throws if either ID does not refer to a Post in this container
+		bool Connect(PostID from, PostID to);
+		// Returns true if the connection existed and was removed
+		bool Disconnect(PostID from, PostID to);
+		bool IsConnected(PostID from, PostID to) const;
+		const std::vector<PostID>& Outgoing(PostID id) const; // Posts that id connects to
+		const std::vector<PostID>& Incoming(PostID id) const; // Posts that connect to id
+		const LuaVector<PostConnection, LuaVectorAccess::checked>& GetConnections() const { return connections; }
+
+		// Queues edits and applies them together on Commit, with the same result as applying them one by one.
+		// Every queued edit is validated before anything is applied, so a failed Commit leaves the container untouched.
+		// Posts queued with InsertBack get their PostID right away and can be referred to by later edits in the same Batch.
+		// A Batch that is destroyed without being committed is rolled back.
+		class Batch
+		{
+		public:
+			Batch(PostContainer& container) : container(container) {}
+			~Batch();
+			Batch(const Batch&) = delete;
+			Batch& operator=(const Batch&) = delete;
+
+			PostID InsertBack(const Post& post);
+			PostID InsertBack(Post&& post);
+			void Erase(PostID id);
+			void RaiseToTop(PostID id);
+			void Connect(PostID from, PostID to);
+			void Disconnect(PostID from, PostID to);
+
+			void Commit(); // Throws if an edit refers to a Post that would not exist when it is applied
+			void Rollback(); // Discards every queued edit; PostIDs returned by InsertBack become stale
+			std::size_t size() const { return edits.size(); }
+			bool Empty() const { return edits.empty(); }
+
+		private:
+			struct InsertEdit { PostID id; Post post; };
+			struct EraseEdit { PostID id; };
+			struct RaiseEdit { PostID id; };
+			struct ConnectEdit { PostID from; PostID to; };
+			struct DisconnectEdit { PostID from; PostID to; };
+			using Edit = std::variant<InsertEdit, EraseEdit, RaiseEdit, ConnectEdit, DisconnectEdit>;
+
+			PostContainer& container;
+			std::vector<Edit> edits;
+
+			void Validate() const;
+		};
 
 	private:
 
-		LuaVector<Post> posts = LuaVector<Post>(false);
+		friend class EditHistory;
+
+		struct Adjacency
+		{
+			std::vector<PostID> outgoing;
+			std::vector<PostID> incoming;
+		};
+
+		LuaVector<PostConnection, LuaVectorAccess::checked> connections;
+		std::unordered_map<PostConnection, std::size_t, ConnectionHash> connection_positions; // Position inside 'connections', starting at 1
+		std::vector<Adjacency> adjacency; // Indexed by PostID::slot
+
+		static constexpr std::uint32_t no_slot = UINT32_MAX;
+
+		struct Slot
+		{
+			std::uint32_t dense = 0; // Position of the Post inside 'posts', starting at 0
+			std::uint32_t generation = 1;
+			std::uint32_t max_generation = 1; // Highest generation ever handed out; Restore can take 'generation' back below it
+			std::uint32_t free_index = no_slot; // Position inside 'free_slots', or no_slot while the slot is in use
+			std::uint32_t below = no_slot; // Neighbours in the draw order
+			std::uint32_t above = no_slot;
+			std::uint64_t stacking = 0; // Taken from 'next_stacking' whenever the slot is put on top, so it grows along the draw order
+		};
 
-		void PropagateIndexShift(iterator start, int offset, std::size_t removed_node_idx = 0);
-		void PropagateIndexShift(iterator start, iterator end, int offset, std::size_t removed_node_idx = 0);
-		void ReconnectNodes(std::unordered_map<std::size_t, std::size_t>& index_changes);
+		LuaVector<Post, LuaVectorAccess::checked> posts;
+		std::vector<PostID> dense_ids; // dense_ids[i] is the ID of the Post at posts[i + 1]
+		std::vector<Slot> slots;
+		std::vector<std::uint32_t> free_slots;
+		std::uint32_t bottom_slot = no_slot;
+		std::uint32_t top_slot = no_slot;
+		std::uint64_t next_stacking = 1;
+
+		PostID AllocateSlot(); // The new slot is neither placed in 'posts' nor linked into the draw order
+		void FreeSlot(PostID id);
+		void TakeFreeSlot(std::uint32_t slot_idx); // Removes a freed slot from 'free_slots' so Restore can reuse it
+		void InsertBackWithID(Post&& post, PostID id);
+		void UpdateSlots(std::size_t first_dense, std::size_t last_dense);
+		void LinkOnTop(std::uint32_t slot_idx);
+		void Unlink(std::uint32_t slot_idx);
+		PostID IDFromSlot(std::uint32_t slot_idx) const;
+		void RemoveConnectionsOf(PostID id);
+
+		// Inverses of Erase and Disconnect, used by EditHistory to put back exactly what was removed
+		void Restore(PostID id, Post&& post, std::size_t dense, PostID below); // id must have been freed and not reused since
+		void RestoreConnection(const PostConnection& connection, std::size_t position);
+		void LinkAbove(std::uint32_t slot_idx, std::uint32_t below_idx); // Links on the bottom if below_idx is no_slot
+		void RenumberStacking();
 	};
 }
\ No newline at end of file
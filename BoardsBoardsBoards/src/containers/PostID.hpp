@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <functional> // std::hash
+
+namespace board
+{
+	// Permanent handle to a Post stored in a PostContainer.
+	// 'slot' points into the container's slot table; 'generation' is bumped every time that slot is freed,
+	// so an ID kept around after its Post was erased never resolves to the Post that reuses the slot.
+	struct PostID
+	{
+		std::uint32_t slot = 0;
+		std::uint32_t generation = 0; // If 0, PostID does not refer to any Post
+
+		bool IsNull() const { return generation == 0; }
+
+		bool operator==(const PostID& rhs) const
+		{
+			return (slot == rhs.slot) && (generation == rhs.generation);
+		}
+	};
+}
+
+template<>
+struct std::hash<board::PostID>
+{
+	std::size_t operator()(const board::PostID& id) const noexcept
+	{
+		return std::hash<std::uint64_t>()((std::uint64_t(id.slot) << 32) | id.generation);
+	}
+};
\ No newline at end of file
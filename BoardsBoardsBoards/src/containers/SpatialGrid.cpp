@@ -0,0 +1,135 @@
+#include <algorithm> // std::find
+#include <cmath> // std::floor
+
+#include "SpatialGrid.hpp"
+
+namespace board
+{
+	int SpatialGrid::CellCoord(float coord) const
+	{
+		return int(std::floor(coord / cell_size));
+	}
+
+	SpatialGrid::CellRange SpatialGrid::CellsOf(const ImRect& rect) const
+	{
+		return CellRange{ CellCoord(rect.Min.x), CellCoord(rect.Min.y), CellCoord(rect.Max.x), CellCoord(rect.Max.y) };
+	}
+
+	std::uint64_t SpatialGrid::CellKey(int x, int y)
+	{
+		return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(y);
+	}
+
+	void SpatialGrid::AddToCells(PostID id, const CellRange& range)
+	{
+		for (int x = range.min_x; x <= range.max_x; x++)
+		{
+			for (int y = range.min_y; y <= range.max_y; y++)
+			{
+				cells[CellKey(x, y)].push_back(id);
+			}
+		}
+	}
+
+	void SpatialGrid::RemoveFromCells(PostID id, const CellRange& range)
+	{
+		for (int x = range.min_x; x <= range.max_x; x++)
+		{
+			for (int y = range.min_y; y <= range.max_y; y++)
+			{
+				auto cell = cells.find(CellKey(x, y));
+				if (cell == cells.end()) continue;
+
+				std::vector<PostID>& ids = cell->second;
+				auto it = std::find(ids.begin(), ids.end(), id);
+				if (it == ids.end()) continue;
+				*it = ids.back();
+				ids.pop_back();
+
+				if (ids.empty()) cells.erase(cell);
+			}
+		}
+	}
+
+	void SpatialGrid::Update(PostID id, const ImRect& rect)
+	{
+		const CellRange range = CellsOf(rect);
+
+		auto found = entries.find(id);
+		if (found == entries.end())
+		{
+			entries.emplace(id, Entry{ rect, range });
+			AddToCells(id, range);
+			return;
+		}
+
+		Entry& entry = found->second;
+		entry.rect = rect;
+		if (entry.cells == range) return; // Moved or resized inside the same cells
+
+		RemoveFromCells(id, entry.cells);
+		AddToCells(id, range);
+		entry.cells = range;
+	}
+
+	void SpatialGrid::Remove(PostID id)
+	{
+		auto found = entries.find(id);
+		if (found == entries.end()) return;
+
+		RemoveFromCells(id, found->second.cells);
+		entries.erase(found);
+	}
+
+	void SpatialGrid::Clear()
+	{
+		cells.clear();
+		entries.clear();
+	}
+
+	void SpatialGrid::QueryPoint(const ImVec2& point, std::vector<PostID>& out) const
+	{
+		auto cell = cells.find(CellKey(CellCoord(point.x), CellCoord(point.y)));
+		if (cell == cells.end()) return;
+
+		for (const PostID& id : cell->second)
+		{
+			if (entries.at(id).rect.Contains(point)) out.push_back(id);
+		}
+	}
+
+	void SpatialGrid::QueryRect(const ImRect& area, std::vector<PostID>& out) const
+	{
+		const CellRange range = CellsOf(area);
+		const std::uint64_t cell_count = std::uint64_t(range.max_x - range.min_x + 1) * std::uint64_t(range.max_y - range.min_y + 1);
+
+		if (cell_count > entries.size()) // Sparse grid under a big area: checking every entry is cheaper
+		{
+			for (const auto& [id, entry] : entries)
+			{
+				if (entry.rect.Overlaps(area)) out.push_back(id);
+			}
+			return;
+		}
+
+		for (int x = range.min_x; x <= range.max_x; x++)
+		{
+			for (int y = range.min_y; y <= range.max_y; y++)
+			{
+				auto cell = cells.find(CellKey(x, y));
+				if (cell == cells.end()) continue;
+
+				for (const PostID& id : cell->second)
+				{
+					const Entry& entry = entries.at(id);
+					// A rectangle spanning several cells is only reported from the first of them inside the area
+					const int first_x = std::max(entry.cells.min_x, range.min_x);
+					const int first_y = std::max(entry.cells.min_y, range.min_y);
+					if (x != first_x || y != first_y) continue;
+
+					if (entry.rect.Overlaps(area)) out.push_back(id);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui_internal.h" // ImRect
+
+#include "PostID.hpp"
+
+namespace board
+{
+	// Uniform grid over the rectangles of Posts, used to answer "what is under this point/area" without visiting every Post.
+	// A Post is stored in every cell its rectangle overlaps. Updating a rectangle only touches the cells that were entered or left.
+	class SpatialGrid
+	{
+	public:
+		SpatialGrid(float cell_size = 256.f) : cell_size(cell_size) {}
+
+		void Update(PostID id, const ImRect& rect); // Inserts id if it is not on the grid yet
+		void Remove(PostID id);
+		void Clear();
+		bool Contains(PostID id) const { return entries.contains(id); }
+		std::size_t size() const { return entries.size(); }
+
+		// Both queries append to 'out' without clearing it, and report every PostID at most once
+		void QueryPoint(const ImVec2& point, std::vector<PostID>& out) const;
+		void QueryRect(const ImRect& area, std::vector<PostID>& out) const;
+
+	private:
+
+		struct CellRange
+		{
+			int min_x = 0;
+			int min_y = 0;
+			int max_x = -1;
+			int max_y = -1;
+
+			bool operator==(const CellRange& rhs) const = default;
+		};
+
+		struct Entry
+		{
+			ImRect rect;
+			CellRange cells;
+		};
+
+		float cell_size;
+		std::unordered_map<std::uint64_t, std::vector<PostID>> cells;
+		std::unordered_map<PostID, Entry> entries;
+
+		int CellCoord(float coord) const;
+		CellRange CellsOf(const ImRect& rect) const;
+		static std::uint64_t CellKey(int x, int y);
+		void AddToCells(PostID id, const CellRange& range);
+		void RemoveFromCells(PostID id, const CellRange& range);
+	};
+}
\ No newline at end of file
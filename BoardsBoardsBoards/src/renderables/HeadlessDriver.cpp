@@ -0,0 +1,165 @@
+#include "HeadlessDriver.hpp"
+
+#include <algorithm> // std::max, std::sort
+#include <chrono>
+#include <cmath> // std::ceil
+#include <cstdio> // std::snprintf
+
+#include "DearImGuiFlags.hpp"
+#include "renderables/tabs/BoardTab.hpp"
+#include "utils/AllocationCounter.hpp"
+#include "fonts/fonts.h"
+
+namespace board
+{
+	using utils::AllocationCounter;
+
+	HeadlessDriver::HeadlessDriver(ImVec2 display_size)
+	{
+		IMGUI_CHECKVERSION();
+		ImGui::SetAllocatorFunctions(AllocationCounter::CountedMalloc, AllocationCounter::CountedFree);
+		ImGui::CreateContext();
+		ImGuiIO& io = ImGui::GetIO();
+		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+		io.IniFilename = nullptr; // Runs must not depend on each other
+		io.DisplaySize = display_size;
+
+		ImGui::StyleColorsDark();
+		ImGuiStyle& style = ImGui::GetStyle();
+		style.Colors[ImGuiCol_ModalWindowDimBg] = ImVec4(0, 0, 0, 0);
+		style.Colors[ImGuiCol_WindowBg] = ImColor(61, 61, 61);
+
+		io.Fonts->AddFontFromMemoryCompressedTTF(KarlaRegular_compressed_data, KarlaRegular_compressed_size, 15.f);
+
+		// A renderer backend would upload this to a texture, building it is all NewFrame needs
+		unsigned char* pixels = nullptr;
+		int width = 0;
+		int height = 0;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+	}
+
+	HeadlessDriver::~HeadlessDriver()
+	{
+		ImGui::DestroyContext();
+	}
+
+	void HeadlessDriver::MoveMouse(ImVec2 pos)
+	{
+		ImGui::GetIO().AddMousePosEvent(pos.x, pos.y);
+	}
+
+	void HeadlessDriver::PressMouse(ImGuiMouseButton button)
+	{
+		ImGui::GetIO().AddMouseButtonEvent(button, true);
+	}
+
+	void HeadlessDriver::ReleaseMouse(ImGuiMouseButton button)
+	{
+		ImGui::GetIO().AddMouseButtonEvent(button, false);
+	}
+
+	void HeadlessDriver::Wheel(float x, float y)
+	{
+		ImGui::GetIO().AddMouseWheelEvent(x, y);
+	}
+
+	void HeadlessDriver::PressKey(ImGuiKey key, bool ctrl, bool shift)
+	{
+		ImGuiIO& io = ImGui::GetIO();
+		if (ctrl) io.AddKeyEvent(ImGuiKey_ModCtrl, true);
+		if (shift) io.AddKeyEvent(ImGuiKey_ModShift, true);
+		io.AddKeyEvent(key, true);
+		io.AddKeyEvent(key, false);
+		if (shift) io.AddKeyEvent(ImGuiKey_ModShift, false);
+		if (ctrl) io.AddKeyEvent(ImGuiKey_ModCtrl, false);
+	}
+
+	void HeadlessDriver::Type(const char* utf8)
+	{
+		ImGui::GetIO().AddInputCharactersUTF8(utf8);
+	}
+
+	HeadlessDriver::FrameStats HeadlessDriver::RenderFrame(const std::function<void()>& draw)
+	{
+		FrameStats stats;
+		ImGui::GetIO().DeltaTime = frame_time;
+
+		const std::uint64_t allocations_before = AllocationCounter::ThisThread();
+		const auto start = std::chrono::steady_clock::now();
+
+		ImGui::NewFrame();
+		draw();
+		ImGui::Render();
+
+		stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		stats.allocations = AllocationCounter::ThisThread() - allocations_before;
+
+		const ImDrawData* draw_data = ImGui::GetDrawData();
+		stats.draw_lists = draw_data->CmdListsCount;
+		stats.vertices = draw_data->TotalVtxCount;
+		stats.indices = draw_data->TotalIdxCount;
+		for (int i = 0; i < draw_data->CmdListsCount; i++)
+		{
+			stats.draw_commands += draw_data->CmdLists[i]->CmdBuffer.Size;
+		}
+		return stats;
+	}
+
+	HeadlessDriver::FrameStats HeadlessDriver::RenderFrame(BoardTab& tab)
+	{
+		return RenderFrame([&tab]()
+		{
+			ImGui::SetNextWindowPos(ImVec2());
+			ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+			ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2());
+			ImGui::Begin("Board", nullptr, MainWindowFlags);
+			ImGui::PopStyleVar();
+			tab.Render();
+			ImGui::End();
+		});
+	}
+
+	double HeadlessDriver::Report::Percentile(double percentile) const
+	{
+		if (frames.empty()) return 0.0;
+
+		std::vector<double> times;
+		times.reserve(frames.size());
+		for (const FrameStats& frame : frames)
+		{
+			times.push_back(frame.milliseconds);
+		}
+		std::sort(times.begin(), times.end());
+
+		// Nearest rank
+		const double rank = std::ceil(percentile / 100.0 * double(times.size()));
+		const std::size_t index = rank < 1.0 ? 0 : std::min(std::size_t(rank) - 1, times.size() - 1);
+		return times[index];
+	}
+
+	HeadlessDriver::FrameStats HeadlessDriver::Report::Peak() const
+	{
+		FrameStats peak;
+		for (const FrameStats& frame : frames)
+		{
+			peak.milliseconds = std::max(peak.milliseconds, frame.milliseconds);
+			peak.allocations = std::max(peak.allocations, frame.allocations);
+			peak.draw_lists = std::max(peak.draw_lists, frame.draw_lists);
+			peak.draw_commands = std::max(peak.draw_commands, frame.draw_commands);
+			peak.vertices = std::max(peak.vertices, frame.vertices);
+			peak.indices = std::max(peak.indices, frame.indices);
+		}
+		return peak;
+	}
+
+	std::string HeadlessDriver::Report::Summary() const
+	{
+		const FrameStats peak = Peak();
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer),
+			"%zu frames: median %.3f ms, p95 %.3f ms, max %.3f ms | peak %d vertices, %d indices, %d draw commands in %d lists, %llu allocations",
+			frames.size(), Percentile(50.0), Percentile(95.0), peak.milliseconds,
+			peak.vertices, peak.indices, peak.draw_commands, peak.draw_lists, (unsigned long long)peak.allocations);
+		return buffer;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "imgui.h"
+
+#include "UI.hpp"
+
+namespace board
+{
+	class BoardTab;
+
+	// Runs ImGui frames without a window or a GPU, so rendering can be measured and tested where Application's DX11 backend is not available.
+	// The context gets the same font and style as Application, input is queued through the io.Add*Event calls a platform backend makes,
+	// and the draw data of every frame is measured instead of drawn.
+	// The driver owns the current ImGui context, so only one may exist at a time.
+	class HeadlessDriver
+	{
+	public:
+		struct FrameStats
+		{
+			double milliseconds = 0.0; // From NewFrame until Render returned
+			std::uint64_t allocations = 0; // Heap allocations made by the calling thread during the frame
+			int draw_lists = 0;
+			int draw_commands = 0;
+			int vertices = 0;
+			int indices = 0;
+		};
+
+		struct Report
+		{
+			std::vector<FrameStats> frames;
+
+			double Percentile(double percentile) const; // Of the frame times, in milliseconds. 50 is the median
+			FrameStats Peak() const; // Highest value of every field over all frames
+			std::string Summary() const;
+		};
+
+		HeadlessDriver(ImVec2 display_size = ImVec2(1280.f, 720.f));
+		~HeadlessDriver();
+		HeadlessDriver(const HeadlessDriver&) = delete;
+		HeadlessDriver& operator=(const HeadlessDriver&) = delete;
+
+		// Queued for the next frame. ImGui spreads events that would cancel each other, like a press and release of the same button,
+		// over the frames that follow, so a click needs at least two frames.
+		void MoveMouse(ImVec2 pos);
+		void PressMouse(ImGuiMouseButton button = ImGuiMouseButton_Left);
+		void ReleaseMouse(ImGuiMouseButton button = ImGuiMouseButton_Left);
+		void Wheel(float x, float y);
+		void PressKey(ImGuiKey key, bool ctrl = false, bool shift = false); // Pressed and released, with the modifiers held around it
+		void Type(const char* utf8);
+
+		// Draws the frame with draw, which is free to open its own windows
+		FrameStats RenderFrame(const std::function<void()>& draw);
+		// The tab fills the display inside a window without decorations or padding, so board positions map to screen positions
+		// as long as the tab is not scrolled
+		FrameStats RenderFrame(BoardTab& tab);
+		FrameStats RenderFrame(UI& ui) { return RenderFrame([&ui]() { ui.Render(); }); }
+
+		template<typename Drawn>
+		Report Run(int frames, Drawn& drawn)
+		{
+			Report report;
+			report.frames.reserve(frames);
+			for (int i = 0; i < frames; i++)
+			{
+				report.frames.push_back(RenderFrame(drawn));
+			}
+			return report;
+		}
+
+		static constexpr float frame_time = 1.f / 60.f; // Fixed, so double clicks and drag thresholds do not depend on the host's speed
+	};
+}
\ No newline at end of file
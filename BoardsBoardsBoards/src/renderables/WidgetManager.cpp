@@ -8,6 +8,7 @@
 
 #include "utils/Error.hpp"
 #include "utils/CommandQueue.hpp"
+#include "utils/FrameProfiler.hpp"
 #include "renderables/windows/ErrorPrompt.hpp"
 #include "renderables/DearImGuiFlags.hpp"
 
@@ -17,31 +18,28 @@ namespace board
 
 	void WidgetManager::CommandQueueLookup()
 	{
-		while (!CommandQueue::empty(CommandQueue::targets::widgetManager))
+		CommandQueue::Drain(CommandQueue::targets::widgetManager, [this](const CommandQueue::Command& command)
 		{
-			auto& pair = CommandQueue::front(CommandQueue::targets::widgetManager);
-			auto& command = pair.first;
-			const std::string& data = pair.second;
-			switch (command)
+			if (const auto* error = std::get_if<CommandQueue::ErrorWindow>(&command))
+			{
+				NewErrorPrompt(error->what);
+			}
+			else if (const auto* open = std::get_if<CommandQueue::OpenFiles>(&command))
 			{
-			case (CommandQueue::commands::createErrorWindow):
-				NewErrorPrompt(data);
-				break;
-			case (CommandQueue::commands::openFile):
 				try
 				{
-					tab_bar.NewBoardTab(data);
+					tab_bar.NewBoardTabs(open->paths);
 				}
 				catch (const std::exception& e)
 				{
 					NewErrorPrompt(e.what());
 				}
-				break;
-			default:
+			}
+			else
+			{
 				throw utils::CommandQueueError("Widget Manager received unknown command.");
 			}
-			CommandQueue::pop(CommandQueue::targets::widgetManager);
-		}
+		});
 	}
 
 	void WidgetManager::NewErrorPrompt(const std::string& what) 
@@ -56,6 +54,7 @@ namespace board
 
 	void WidgetManager::RenderAll()
 	{
+		BOARD_PROFILE_SCOPE(WidgetManagerRenderAll);
 		ImVec2 size = ImGui::GetMainViewport()->WorkSize;
 		ImVec2 pos = ImGui::GetMainViewport()->WorkPos;
 		ImGui::SetNextWindowSize(size);
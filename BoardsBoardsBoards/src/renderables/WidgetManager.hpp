@@ -17,6 +17,7 @@ namespace board
 		void RenderAll();
 		void NewErrorPrompt(const std::string& what);
 		bool hasActiveTab() { return tab_bar.hasActiveTab(); }
+		bool NeedsRedraw() const { return tab_bar.NeedsRedraw(); }
 		
 		// Will throw if !hasActiveTab()
 		BoardTab& getActiveTab() { return tab_bar.getActiveTab(); }
@@ -44,20 +44,11 @@ namespace board
 			return (color[0] >= 0 && color[1] >= 0 && color[2] >= 0);
 		}
 
-
-		std::size_t GetIdx() const { return Idx; }
-		void SetIdx(std::size_t new_idx) { Idx = new_idx; }
-		void IndexShift(int offset) { Idx += offset; }
-
 		
 		LuaVector<PostContent> content = LuaVector<PostContent>(true);
 		std::size_t editing_content = 0;
 		std::pair<float, float> display_pos;
 		float color[3]{ -1.f, -1.f, -1.f };
 		Tags tags;		
-		
-	private:
-		std::size_t Idx = 0; // If 0, Post is not inserted into PostContainer
-		
 	};
 }
\ No newline at end of file
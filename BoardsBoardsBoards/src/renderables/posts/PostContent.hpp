@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <variant>
 #include <string>
 #include <utility> // std pair
@@ -81,6 +83,11 @@ namespace board
 			return std::get<ImageInfo>(data);
 		}
 
+		// Changes whenever the content is edited, so caches of its layout know when to measure it again.
+		// Edits made through AsString() have to call Edited(); copies keep the revision, as they hold the same content.
+		std::uint64_t GetRevision() const { return revision; }
+		void Edited() { revision = NextRevision(); }
+
 		bool operator==(const PostContent& rhs) const
 		{
 			return data == rhs.data;
@@ -100,5 +107,13 @@ namespace board
 
 	private:
 		std::variant<string, ImageInfo> data;
+		std::uint64_t revision = NextRevision();
+
+		// Never reused, Posts are parsed on other threads while the board is shown
+		static std::uint64_t NextRevision()
+		{
+			static std::atomic<std::uint64_t> next_revision = 1;
+			return next_revision.fetch_add(1, std::memory_order_relaxed);
+		}
 	};
 }
@@ -11,10 +11,8 @@ namespace board
 {
 	using utils::LuaValue;
 
-	class TagEntryList : public LuaVector<LuaValue>
+	class TagEntryList : public LuaVector<LuaValue, LuaVectorAccess::checked>
 	{
-	public:
-		TagEntryList() : LuaVector<LuaValue>(false) {}
 	};
 
 	class Tags
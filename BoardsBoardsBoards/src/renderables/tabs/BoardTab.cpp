@@ -7,72 +7,95 @@
 #include "renderables/posts/PostContent.hpp"
 #include "utils/BoardColors.hpp"
 #include "utils/Bezier.hpp"
+#include "utils/AllocationCounter.hpp"
 #include "utils/CommandQueue.hpp"
 #include "utils/Error.hpp"
+#include "utils/FrameProfiler.hpp"
 
+#include <algorithm> // std::find, std::sort
+#include <cmath> // std::exp2, std::log2, std::pow, std::round
+#include <cstring> // std::strchr
 #include <iostream>
+#include <sstream>
 
 using utils::BoardColors;
 using utils::CubicBezier;
 using utils::GetCubicBezier;
 using utils::DrawCubicBezier;
-using utils::IsMouseOnCubicBezier;
+using utils::TessellateCubicBezier;
+using utils::GetContainingRectForPolyline;
+using utils::GetDistanceToCubicBezier;
+using utils::DrawPolyline;
 
 namespace board
 {
 	BoardTab::BoardTab(string unique_ID) : Widget(unique_ID), path(std::move(unique_ID)) {}
 	BoardTab::BoardTab(PostContainer&& container, string path) : container(std::move(container)), Widget(path), path(std::move(path)) {}
 	BoardTab::BoardTab(const PostContainer& container, string path) : container(container), Widget(path), path(std::move(path)) {}
+	BoardTab::BoardTab(std::unique_ptr<utils::BoardLoader> loader) : Widget(loader->Path()), path(loader->Path()), loader(std::move(loader)) {}
 
 	
-	void RenderText(Post& post, std::size_t content_idx, std::pair<ImRect, ImRect>& content_rects, BoardColors& colors, float s_unit)
+	// Text widgets edit the string in place, so the history copies it right before the widget runs, and only while the widget is active
+	void InputTextRecorded(EditHistory& history, PostContainer& container, PostID id, std::size_t content_idx, const ImVec2& size = ImVec2())
 	{
+		if (ImGui::GetActiveID() == ImGui::GetID(""))
+		{
+			history.WatchText(container, id, content_idx);
+		}
+		PostContent& content = container[id].content[content_idx];
+		if (ImGui::InputTextMultiline("", &content.AsString(), size))
+		{
+			content.Edited();
+			history.TextChanged(container);
+		}
+	}
+
+	const char* empty_post_text = "Double click here"; // Longer than the small string buffer, so never a std::string built every frame
+	const char* unknown_content_text = "UNKNOWN CONTENT TYPE";
+
+	const char* ShownText(const PostContent& content)
+	{
+		if (content.GetType() != ContentType::text) return unknown_content_text;
+		const auto& text = content.AsString();
+		return (text.empty() ? empty_post_text : text.c_str());
+	}
+
+	// The text is drawn at the cursor, which is the top left corner of content_rects.first scaled by zoom.
+	// It goes straight into the draw list, its size is already known from the Post's TextLayout and ImGui::Text would measure it again
+	void RenderText(PostContainer& container, PostID id, EditHistory& history, std::size_t content_idx, const std::pair<ImRect, ImRect>& content_rects, BoardColors& colors, float zoom)
+	{
+		Post& post = container[id];
 		PostContent& content = post.content[content_idx];
 
-		const std::string empty_post = "Double click here";
-		auto& text = content.AsString();
-		auto& string = (text.empty() ? empty_post : text);
-		
 		const bool is_editing = post.editing_content == content_idx;
 		auto& bg_color = (post.HasColor() ? post.color : colors.post);
 		auto& text_color = (is_editing ? bg_color : colors.text);
 
-		auto pos = ImGui::GetCursorPos();
-
-		ImGui::TextColored(colors.ArrayToImColor(text_color), string.data());
-
-		ImRect text_rect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
-		content_rects.first = text_rect;
+		ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImGui::GetCursorScreenPos(), colors.ArrayToImColor(text_color), ShownText(content));
 
 		if (!is_editing) return;
 
-		ImGui::SetCursorPos(pos);
-
-		ImRect edit_rect = text_rect;
-		edit_rect.Expand(s_unit * 2);
-		
 		ImGui::PushID((void*)&content);
-		ImGui::InputTextMultiline("", &text, edit_rect.GetSize());
+		InputTextRecorded(history, container, id, content_idx, content_rects.second.GetSize() * zoom);
 		ImGui::PopID();
-
-		content_rects.second = edit_rect;
 	}
 	
-	void RenderContent(Post& post, std::size_t content_idx, std::pair<ImRect, ImRect>& content_rects, BoardColors& colors, float s_unit)
+	void RenderContent(PostContainer& container, PostID id, EditHistory& history, std::size_t content_idx, const std::pair<ImRect, ImRect>& content_rects, BoardColors& colors, float zoom)
 	{
-		PostContent& content = post.content[content_idx];
+		PostContent& content = container[id].content[content_idx];
 		switch (content.GetType())
 		{
 		case(ContentType::text):
-			RenderText(post, content_idx, content_rects, colors, s_unit);
+			RenderText(container, id, history, content_idx, content_rects, colors, zoom);
 			break;
 		default:
-			ImGui::Text("UNKNOWN CONTENT TYPE");
+			ImGui::TextUnformatted(unknown_content_text);
 			break;
 		}
 	}
 
-	void StartEditingPost(Post& post, LuaVector<std::pair<ImRect, ImRect>>& content_pairs, ImVec2& mouse_pos)
+	// mouse_pos is in board units, as the rectangles
+	void StartEditingPost(Post& post, LuaVector<std::pair<ImRect, ImRect>, LuaVectorAccess::unchecked>& content_pairs, const ImVec2& mouse_pos)
 	{
 		auto& content = post.content;
 
@@ -190,115 +213,371 @@ namespace board
 
 	void BoardTab::CommandQueueLookup()
 	{
-		while (!CommandQueue::empty(CommandQueue::targets::currentTab))
+		BOARD_PROFILE_SCOPE(CommandQueueLookup);
+		CommandQueue::Drain(CommandQueue::targets::currentTab, [this](const CommandQueue::Command& command)
 		{
-			auto& pair = CommandQueue::front(CommandQueue::targets::currentTab);
-			auto& command = pair.first;
-			const std::string& data = pair.second;
-
-			switch (command)
+			if (std::holds_alternative<CommandQueue::OpenBoardOptions>(command))
 			{
-			case (CommandQueue::commands::openBoardOptions):
 				curr_frame.popups.table_options.open = true;
-				break;
-			default:
+			}
+			else if (std::holds_alternative<CommandQueue::Undo>(command))
+			{
+				StepHistory(false);
+			}
+			else if (std::holds_alternative<CommandQueue::Redo>(command))
+			{
+				StepHistory(true);
+			}
+			else
+			{
 				throw utils::CommandQueueError("Current Tab received unknown command.");
 			}
-
-			CommandQueue::pop(CommandQueue::targets::currentTab);
-			
-		}
+		});
 	}
 
-	void BoardTab::SetSelectedPost(std::size_t idx)
+	void BoardTab::SetSelectedPost(PostID id)
 	{
-		if (curr_frame.selections.leftclicked == idx) return;
+		if (curr_frame.selections.leftclicked == id) return;
 
-		if (curr_frame.selections.leftclicked > 0) // "clear" the old selected node, if any
+		if (container.Contains(curr_frame.selections.leftclicked)) // "clear" the old selected node, if any
 		{
 			container[curr_frame.selections.leftclicked].editing_content = 0;
 		}
+		history.EndContinuousEdit(); // Typing into another Post starts a new step
 
-		if (idx == 0)
+		if (id.IsNull())
 		{
-			curr_frame.selections.leftclicked = 0;
+			curr_frame.selections.leftclicked = PostID();
 			return;
 		}
-		std::size_t new_idx = container.MoveToLastPosition(idx)->GetIdx();
-		curr_frame.selections.leftclicked = new_idx;
-		curr_frame.just_selected_post = true;
+		container.RaiseToTop(id);
+		curr_frame.selections.leftclicked = id;
+		curr_frame.just_selected_post = id;
+	}
+
+	void BoardTab::CloseEditPostPopup(bool keep_edits)
+	{
+		auto& vars = curr_frame.popups.editing_post;
+		if (vars.Recording())
+		{
+			vars.SetRecording(false);
+			if (keep_edits)
+			{
+				history.EndGroup();
+			}
+			else
+			{
+				history.CancelGroup(container);
+				DropLayoutCaches();
+			}
+		}
+		vars.SetOpen(false);
+	}
+
+	// The window stays open and starts a new group on its next frame, so Cancel only reverts what it edited since
+	void BoardTab::EndEditPostGroup()
+	{
+		auto& vars = curr_frame.popups.editing_post;
+		if (!vars.Recording()) return;
+		vars.SetRecording(false);
+		history.EndGroup();
+	}
+
+	void BoardTab::StepHistory(bool redo)
+	{
+		CloseEditPostPopup(true);
+		SetSelectedPost(PostID()); // Also stops editing text the step may change
+
+		try
+		{
+			if (redo) history.Redo(container);
+			else history.Undo(container);
+		}
+		catch (const std::exception& e)
+		{
+			std::stringstream stream;
+			stream << "Could not " << (redo ? "redo" : "undo") << " the last edit: " << e.what() << '\n';
+			CommandQueue::CreateErrorWindow(stream.str());
+		}
 
-		curr_frame.popups.editing_post.WillRefresh(true);
+		DropLayoutCaches();
+	}
+
+	void BoardTab::DropLayoutCaches()
+	{
+		// Undone edits may have moved Posts that are culled, so every Post is laid out again.
+		// The text layouts stay, undoing a text edit gives the content a new revision
+		post_grid.Clear();
+		connection_tree_dirty = true;
+		curr_frame.new_connection.Reset();
+		curr_frame.hovering.connection = 0;
+		if (!container.Contains(curr_frame.selections.rightclicked))
+		{
+			curr_frame.selections.rightclicked = PostID();
+		}
 	}
 	
-	void BoardTab::RenderPost(Post& post)
+	BoardTab::PostRenderingInfo& BoardTab::GetRenderingInfo(PostID id)
+	{
+		PostRenderingInfo& info = posts_info[id.slot + 1];
+		if (info.id != id) // Slot was reused by a new Post, the cached rects are stale
+		{
+			info = PostRenderingInfo();
+			info.id = id;
+		}
+		return info;
+	}
+
+	ImVec2 BoardTab::ToBoard(const ImVec2& screen_pos) const
+	{
+		return (screen_pos - curr_frame.board_origin) / zoom;
+	}
+
+	ImRect BoardTab::ToScreen(const ImRect& board_rect) const
+	{
+		return ImRect(curr_frame.board_origin + board_rect.Min * zoom, curr_frame.board_origin + board_rect.Max * zoom);
+	}
+
+	bool BoardTab::ZoomAround(float new_zoom, const ImVec2& anchor)
+	{
+		new_zoom = ImClamp(new_zoom, camera.min_zoom, camera.max_zoom);
+		if (new_zoom == zoom) return false;
+
+		ImGuiWindow* window = ImGui::GetCurrentWindow();
+		const ImVec2 board_anchor = (anchor - window->Pos + window->Scroll) / zoom;
+		// Set directly instead of through ImGui::SetScrollX/Y, which only scroll on the next frame, so this frame is already drawn from it.
+		// The content size is measured from CursorStartPos, placed by Begin at the old scroll, so it moves along
+		const ImVec2 new_scroll = ImMax(window->Pos + board_anchor * new_zoom - anchor, ImVec2(0.f, 0.f));
+		window->DC.CursorStartPos += window->Scroll - new_scroll;
+		window->Scroll = new_scroll;
+		zoom = new_zoom;
+		return true;
+	}
+
+	void BoardTab::SetZoom(float new_zoom)
+	{
+		requested_zoom = new_zoom;
+	}
+
+	// The font size is given explicitly, so the zoom applied to the window does not change the result
+	bool BoardTab::MeasureText(const PostContent& content, TextLayout& layout) const
+	{
+		ImFont* font = ImGui::GetFont();
+		if (layout.revision == content.GetRevision() && layout.font == font && layout.font_size == s_unit) return false;
+
+		const char* text = ShownText(content);
+		layout.size = font->CalcTextSizeA(s_unit, FLT_MAX, 0.f, text);
+		layout.size.x = IM_FLOOR(layout.size.x + 0.99999f); // Rounded as ImGui::CalcTextSize does
+
+		layout.line_breaks.clear();
+		for (const char* line_break = std::strchr(text, '\n'); line_break != nullptr; line_break = std::strchr(line_break + 1, '\n'))
+		{
+			layout.line_breaks.push_back(std::uint32_t(line_break - text));
+		}
+
+		layout.revision = content.GetRevision();
+		layout.font = font;
+		layout.font_size = s_unit;
+		return true;
+	}
+
+	// Places the measured contents one under the other, as ImGui::NewLine would
+	void BoardTab::PlacePost(const Post& post, PostRenderingInfo& info) const
+	{
+		const float line_gap = s_unit + ImGui::GetStyle().ItemSpacing.y * 2.f;
+
+		ImVec2 cursor = ImVec2(post.display_pos.first, post.display_pos.second);
+		ImRect total_rect = ImRect(cursor, cursor);
+		for (std::size_t i = 1; i <= post.content.size(); i++)
+		{
+			const ImVec2 size = info.text_layouts[i].size;
+
+			auto& [text_rect, edit_rect] = info.content_rects[i];
+			text_rect = ImRect(cursor, cursor + size);
+			edit_rect = text_rect;
+			edit_rect.Expand(s_unit * 2);
+			total_rect.Add(text_rect);
+
+			float height = size.y;
+			if (post.editing_content == i) // The text box starts at the text and is as large as edit_rect
+			{
+				const ImRect text_box = ImRect(cursor, cursor + edit_rect.GetSize());
+				total_rect.Add(text_box);
+				height = text_box.GetHeight();
+			}
+			cursor.y += height + line_gap;
+		}
+		total_rect.Expand(s_unit * 0.5f);
+		info.total_rect = total_rect;
+
+		info.placed_font_size = s_unit;
+		info.placed_pos = post.display_pos;
+		info.placed_contents = post.content.size();
+		info.placed_editing = post.editing_content;
+	}
+
+	BoardTab::PostRenderingInfo& BoardTab::LayoutPost(PostID id)
+	{
+		const Post& post = container[id];
+		PostRenderingInfo& info = GetRenderingInfo(id);
+
+		if (info.content_rects.size() < post.content.size())
+		{
+			info.content_rects.Resize(int(post.content.size()));
+			info.text_layouts.Resize(int(post.content.size()));
+		}
+
+		// Text is only measured when it was edited, and the Post only placed again when it or its text changed
+		bool texts_changed = false;
+		for (std::size_t i = 1; i <= post.content.size(); i++)
+		{
+			texts_changed |= MeasureText(post.content[i], info.text_layouts[i]);
+		}
+		const bool placed = !texts_changed && info.placed_font_size == s_unit && info.placed_pos == post.display_pos &&
+							info.placed_contents == post.content.size() && info.placed_editing == post.editing_content;
+		if (!placed)
+		{
+			const ImRect old_rect = info.total_rect;
+			PlacePost(post, info);
+			const bool moved = old_rect.Min.x != info.total_rect.Min.x || old_rect.Min.y != info.total_rect.Min.y ||
+							   old_rect.Max.x != info.total_rect.Max.x || old_rect.Max.y != info.total_rect.Max.y;
+			if (moved) moved_posts.push_back(id);
+		}
+		if (!placed || !post_grid.Contains(id))
+		{
+			ImRect hit_rect = info.total_rect;
+			hit_rect.Expand(s_unit * 0.5f); // Includes the outer border
+			post_grid.Update(id, hit_rect);
+		}
+		content_max = ImMax(content_max, info.total_rect.Max);
+		return info;
+	}
+
+	void BoardTab::RenderPost(PostID id)
 	{
 		BoardColors& color_table = container.board_options.color_table;
 
 		ImDrawList* draw_list = ImGui::GetWindowDrawList();
-		auto& display_pos = post.display_pos;
-		std::size_t idx = post.GetIdx();
+		Post& post = container[id];
+		const PostRenderingInfo& info = LayoutPost(id);
 
-		ImRect& total_rect = posts_info[idx].total_rect;
+		const ImRect total_rect = ToScreen(info.total_rect);
 		ImRect item_rect_outer = total_rect;
-		item_rect_outer.Expand(s_unit * 0.5f);
+		item_rect_outer.Expand(s_unit * zoom * 0.5f);
 
-		ImGui::SetCursorPosX(display_pos.first);
-		ImGui::SetCursorPosY(display_pos.second);
-		
-		const bool has_info = total_rect.GetHeight() != 0;
-		const bool has_color = (post.color[0] >= 0 && post.color[1] >= 0 && post.color[2] >= 0);
-
-		const auto& color = (has_color ? post.color : color_table.post);
+		const auto& color = (post.HasColor() ? post.color : color_table.post);
 
 		ImColor post_color_inner = ImColor(color[0], color[1], color[2]);
 		ImColor post_color_outer = ImColor(color[0] * 0.70f, color[1] * 0.70f, color[2] * 0.70f);
 
-		if (has_info)
+		draw_list->AddRectFilled(item_rect_outer.Min, item_rect_outer.Max, post_color_outer, 1.f);
+		draw_list->AddRectFilled(total_rect.Min, total_rect.Max, post_color_inner, 1.f);
+
+		const Detail post_detail = (post.editing_content != 0 ? Detail::full : detail);
+		if (post_detail == Detail::rects || post.content.Empty()) return;
+
+		if (post_detail == Detail::titles)
 		{
-			draw_list->AddRectFilled(item_rect_outer.Min, item_rect_outer.Max, post_color_outer, 1.f);
-			draw_list->AddRectFilled(total_rect.Min, total_rect.Max, post_color_inner, 1.f);
+			// First line of the first content, drawn straight into the draw list without submitting an item
+			const char* title = ShownText(post.content[1]);
+			const auto& line_breaks = info.text_layouts[1].line_breaks;
+			const ImVec4 clip_rect = ImVec4(total_rect.Min.x, total_rect.Min.y, total_rect.Max.x, total_rect.Max.y);
+			draw_list->AddText(ImGui::GetFont(), s_unit * zoom, ToScreen(info.content_rects[1].first).Min,
+				color_table.ArrayToImColor(color_table.text), title, (line_breaks.empty() ? nullptr : title + line_breaks.front()), 0.f, &clip_rect);
+			return;
 		}
 
-		ImGui::BeginGroup();
-
 		for (std::size_t i = 1; i <= post.content.size(); i++)
 		{
-			auto& content_rects = posts_info[idx].content_rects[i];
-			if (i > 1) ImGui::NewLine();
-			RenderContent(post, i, content_rects, color_table, s_unit);			
+			const auto& content_rects = info.content_rects[i];
+			ImGui::SetCursorPos(content_rects.first.Min * zoom);
+			RenderContent(container, id, history, i, content_rects, color_table, zoom);
 		}
 
-		ImGui::EndGroup();
-
-		total_rect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
-		total_rect.Expand(s_unit * 0.5f);
+		#ifdef BOARD_DEBUG
+		ImGui::SetCursorPos(ImVec2(info.total_rect.Max.x + s_unit, info.total_rect.Min.y) * zoom);
+		ImGui::Text("%zu", container.PositionOf(id));
+		#endif
+		
+	}
 
-		ImVec2& mouse_pos = curr_frame.mouse.pos;
-		const bool mouse_inner = total_rect.Contains(mouse_pos);
-		const bool mouse_outer = item_rect_outer.Contains(mouse_pos);
+	void BoardTab::RenderVisiblePosts()
+	{
+		BOARD_PROFILE_SCOPE(PostLayout);
+		const ImVec2 scroll = ImVec2(ImGui::GetScrollX(), ImGui::GetScrollY());
+		const ImRect visible = ImRect(scroll / zoom, (scroll + ImGui::GetWindowSize()) / zoom); // In board units
 
-			if (mouse_inner || mouse_outer)
+		if (post_grid.size() != container.size())
+		{
+			// Posts that were never laid out have no rectangle to be culled with, so the whole draw order is laid out once
+			content_max = ImVec2();
+			for (PostID id = container.Bottom(); !id.IsNull(); id = container.Above(id))
 			{
-				curr_frame.hovering.post = idx;
-				
-				if (curr_frame.mouse.leftclicked)
+				if (LayoutPost(id).total_rect.Overlaps(visible))
 				{
-					curr_frame.just_selected_post = idx;
+					RenderPost(id);
 				}
-				else if (curr_frame.mouse.rightclicked)
-				{
-					curr_frame.selections.rightclicked = idx;
-				}				
 			}
-		
+			if (post_grid.size() != container.size())
+			{
+				post_grid.Clear(); // Still holds Posts that were erased elsewhere, rebuilt on the next frame
+			}
+		}
+		else
+		{
+			visible_posts.clear();
+			post_grid.QueryRect(visible, visible_posts);
 
-		#ifdef BOARD_DEBUG
-		ImGui::SameLine();
-		ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetFontSize());
-		ImGui::Text("%i", idx);
-		#endif
-		
+			// Widgets of the Post being edited have to be submitted even if it was scrolled away
+			const PostID selected = curr_frame.selections.leftclicked;
+			if (container.Contains(selected) && std::find(visible_posts.begin(), visible_posts.end(), selected) == visible_posts.end())
+			{
+				visible_posts.push_back(selected);
+			}
+
+			std::erase_if(visible_posts, [this](PostID id) { return !container.Contains(id); });
+			std::sort(visible_posts.begin(), visible_posts.end(), [this](PostID lhs, PostID rhs) { return container.IsAbove(rhs, lhs); });
+
+			for (const PostID& id : visible_posts)
+			{
+				RenderPost(id);
+			}
+		}
+
+		// Culled Posts submit no items, so the scrolling area is kept by hand
+		ImGui::SetCursorPos(content_max * zoom);
+	}
+
+	void BoardTab::FindHoveredPost()
+	{
+		grid_results.clear();
+		post_grid.QueryPoint(ToBoard(curr_frame.mouse.pos), grid_results);
+
+		PostID hovered;
+		for (const PostID& id : grid_results)
+		{
+			if (!container.Contains(id)) // Erased since it was last laid out
+			{
+				post_grid.Remove(id);
+				continue;
+			}
+			if (hovered.IsNull() || container.IsAbove(id, hovered))
+			{
+				hovered = id;
+			}
+		}
+		if (hovered.IsNull()) return;
+
+		curr_frame.hovering.post = hovered;
+
+		if (curr_frame.mouse.leftclicked)
+		{
+			curr_frame.just_selected_post = hovered;
+		}
+		else if (curr_frame.mouse.rightclicked)
+		{
+			curr_frame.selections.rightclicked = hovered;
+		}
 	}
 
 	ImVec2 GetRectCenter(const ImRect& rect)
@@ -311,7 +590,7 @@ namespace board
 
 	void BoardTab::DragSelectedPost()
 	{
-		if (curr_frame.selections.leftclicked == 0) return;
+		if (curr_frame.selections.leftclicked.IsNull()) return;
 
 		Post& current_post = container[curr_frame.selections.leftclicked];
 		auto& post_display_pos = current_post.display_pos;
@@ -319,10 +598,10 @@ namespace board
 		if (current_post.editing_content != 0) return;
 
 		curr_frame.mouse.dragging_post = true;
+		EndEditPostGroup();
 		
-		ImVec2 delta = ImGui::GetMouseDragDelta();
-		post_display_pos.first += delta.x;
-		post_display_pos.second += delta.y;
+		ImVec2 delta = ImGui::GetMouseDragDelta() / zoom;
+		history.MovePost(container, curr_frame.selections.leftclicked, { post_display_pos.first + delta.x, post_display_pos.second + delta.y }); // One step until the mouse is released
 		ImGui::ResetMouseDragDelta();
 	}
 
@@ -335,6 +614,11 @@ namespace board
 
 		ImGui::Begin("Debug Window", NULL, PopupWindowFlags);
 
+		ImGui::Text("Heap allocations last frame: %llu", (unsigned long long)utils::AllocationCounter::LastFrame());
+		static constexpr const char* detail_names[] = { "Full", "Titles", "Rectangles" };
+		ImGui::Text("Zoom: %.2f, detail: %s", zoom, detail_names[int(detail)]);
+
+		ImGui::NewLine();
 		ImGui::Text("Rendering context info");		
 		ImGui::Text("Max: Right: %2.f, Down: %2.f", content_max.x, content_max.y);
 		
@@ -359,17 +643,17 @@ namespace board
 			ImGui::Text("Drag: %1.f, %1.f", drag.x, drag.y);
 		}
 		
-		if (curr_frame.selections.leftclicked > 0)
+		if (!curr_frame.selections.leftclicked.IsNull())
 		{
 			const Post& post = container[curr_frame.selections.leftclicked];
 			const auto& content = post.content;
 
-			const PostRenderingInfo& post_info = posts_info[curr_frame.selections.leftclicked];
+			const PostRenderingInfo& post_info = GetRenderingInfo(curr_frame.selections.leftclicked);
 			const ImRect& total_rect = post_info.total_rect;
 			const auto& content_rects = post_info.content_rects;
 
 			ImGui::NewLine();
-			ImGui::Text("Left clicked Post: %i", curr_frame.selections.leftclicked);
+			ImGui::Text("Left clicked Post: %zu", container.PositionOf(curr_frame.selections.leftclicked));
 			ImGui::Text("Display Pos: %1.f, %1.f", post.display_pos.first, post.display_pos.second);
 			ImGui::Text("Rect Min: %1.f, %1.f", total_rect.Min.x, total_rect.Min.y);
 			ImGui::Text("Rect Max: %1.f, %1.f", total_rect.Max.x, total_rect.Max.y);
@@ -395,21 +679,21 @@ namespace board
 
 			if (curr_frame.mouse.dragging_post)
 			{
-				ImGui::Text("Currently dragging post %i", post.GetIdx());
+				ImGui::Text("Currently dragging post %zu", container.PositionOf(curr_frame.selections.leftclicked));
 			}
 		}
-		if (curr_frame.selections.rightclicked != 0)
+		if (!curr_frame.selections.rightclicked.IsNull())
 		{
 			ImGui::NewLine();
-			ImGui::Text("Right clicked post: %i", curr_frame.selections.rightclicked);
+			ImGui::Text("Right clicked post: %zu", container.PositionOf(curr_frame.selections.rightclicked));
 		}
 		if (curr_frame.hovering.connection > 0)
 		{
 			ImGui::Text("Hovered connection: %i", curr_frame.hovering.connection);
 		}
-		if (curr_frame.hovering.post > 0)
+		if (!curr_frame.hovering.post.IsNull())
 		{
-			ImGui::Text("Hovered post: %i", curr_frame.hovering.post);
+			ImGui::Text("Hovered post: %zu", container.PositionOf(curr_frame.hovering.post));
 		}
 
 		ImGui::End();
@@ -417,6 +701,7 @@ namespace board
 
 	void BoardTab::PopulateCurrentFrameInfo()
 	{
+		BOARD_PROFILE_SCOPE(PopulateCurrentFrameInfo);
 		curr_frame.Reset();
 		curr_frame.mouse.valid = ImGui::IsMousePosValid();
 		curr_frame.mouse.leftclicked = ImGui::IsMouseClicked(0);
@@ -427,38 +712,113 @@ namespace board
 		curr_frame.mouse.pos = ImGui::GetMousePos();
 	}
 
+	BoardTab::ConnectionRenderingInfo& BoardTab::GetConnectionInfo(const PostContainer::PostConnection& connection)
+	{
+		ConnectionRenderingInfo& info = connections_info[connection];
+
+		const ImVec2 start_p = GetRectCenter(GetRenderingInfo(connection.from).total_rect);
+		const ImVec2 end_p = GetRectCenter(GetRenderingInfo(connection.to).total_rect);
+
+		const CubicBezier& bezier = info.bezier;
+		const bool moved = start_p.x != bezier.P0.x || start_p.y != bezier.P0.y || end_p.x != bezier.P3.x || end_p.y != bezier.P3.y;
+		if (info.polyline.empty() || moved || info.tessellation_zoom != tessellation_zoom) // One of the Posts moved or was resized
+		{
+			info.bezier = GetCubicBezier(start_p, end_p, 0.25f / tessellation_zoom); // A quarter of a pixel on screen
+			info.tessellation_zoom = tessellation_zoom;
+			TessellateCubicBezier(info.bezier, info.polyline);
+			info.bounds = GetContainingRectForPolyline(info.polyline, 0.f);
+		}
+		return info;
+	}
+
+	void BoardTab::UpdateConnectionTree()
+	{
+		using PostConnection = PostContainer::PostConnection;
+		const auto& connections = container.GetConnections();
+
+		if (connection_tree_dirty || connection_tree.size() != connections.size())
+		{
+			tree_builds++;
+			tree_bounds.clear();
+			for (std::size_t i = 1; i <= connections.size(); i++)
+			{
+				ConnectionRenderingInfo& info = GetConnectionInfo(connections[i]);
+				info.position = i;
+				info.tree_build = tree_builds;
+				tree_bounds.push_back(info.bounds);
+			}
+			std::erase_if(connections_info, [this](const auto& pair) { return pair.second.tree_build != tree_builds; });
+
+			connection_tree.Build(tree_bounds);
+			connection_tree_dirty = false;
+			moved_posts.clear();
+			return;
+		}
+
+		// Only the connections of Posts that moved need new polylines
+		for (const PostID& id : moved_posts)
+		{
+			if (!container.Contains(id)) continue;
+			for (const PostID& to : container.Outgoing(id))
+			{
+				const ConnectionRenderingInfo& info = GetConnectionInfo(PostConnection(id, to));
+				connection_tree.Refit(info.position - 1, info.bounds);
+			}
+			for (const PostID& from : container.Incoming(id))
+			{
+				const ConnectionRenderingInfo& info = GetConnectionInfo(PostConnection(from, id));
+				connection_tree.Refit(info.position - 1, info.bounds);
+			}
+		}
+		moved_posts.clear();
+	}
+
 	void BoardTab::RenderConnections()
 	{
+		BOARD_PROFILE_SCOPE(RenderConnections);
 		ImDrawList* draw_list = ImGui::GetWindowDrawList();
 		BoardColors& colors = container.board_options.color_table;
 
 		std::size_t hovered = 0;
 
-		const float connection_thickness = s_unit / 3;
-		const float selection_threshold = s_unit / 2;
-		const float selected_connection_thickness = 0.8f * s_unit;
+		const float connection_thickness = ImMax(1.f, s_unit * zoom / 3);
+		const float selection_threshold = s_unit / 2 / zoom; // In board units, the same distance on screen at any zoom
+		const float selected_connection_thickness = ImMax(2.f, 0.8f * s_unit * zoom);
 
-		auto& DrawConnection = DrawCubicBezier;
+		const auto& connections = container.GetConnections();
+		const ImVec2& origin = curr_frame.board_origin;
+		const ImVec2 mouse_pos = ToBoard(curr_frame.mouse.pos);
+		const ImVec2 scroll = ImVec2(ImGui::GetScrollX(), ImGui::GetScrollY());
+		const ImRect visible = ImRect(scroll / zoom, (scroll + ImGui::GetWindowSize()) / zoom); // In board units
 
-		for (std::size_t i = 1; i <= container.connections.size(); i++)
-		{
-			auto& connection = container.connections[i];
+		UpdateConnectionTree();
 
-			draw_list->ChannelsSetCurrent(1);
+		ImRect culling_area = visible;
+		culling_area.Expand(selection_threshold);
 
-			std::size_t start_idx = connection.from;
-			std::size_t end_idx = connection.to;
-			
-			ImVec2 start_p = GetRectCenter(posts_info[start_idx].total_rect);
-			ImVec2 end_p = GetRectCenter(posts_info[end_idx].total_rect);
+		tree_results.clear();
+		connection_tree.QueryRect(culling_area, tree_results);
+		std::sort(tree_results.begin(), tree_results.end()); // Keeps the drawing order of the connections
 
-			CubicBezier bezier = GetCubicBezier(start_p, end_p);
+		draw_list->ChannelsSetCurrent(1);
+		for (const std::size_t& item : tree_results)
+		{
+			const ConnectionRenderingInfo& info = GetConnectionInfo(connections[int(item) + 1]);
+			DrawPolyline(info.polyline, origin, zoom, polyline_scratch, colors.ArrayToImColor(colors.connection), connection_thickness);
+		}
 
-			DrawCubicBezier(bezier, colors.ArrayToImColor(colors.connection), connection_thickness);
+		// When connections overlap under the mouse, the one drawn last is hovered
+		tree_results.clear();
+		connection_tree.QueryRect(ImRect(mouse_pos - ImVec2(selection_threshold, selection_threshold), mouse_pos + ImVec2(selection_threshold, selection_threshold)), tree_results);
+		for (const std::size_t& item : tree_results)
+		{
+			const std::size_t position = item + 1;
+			if (position <= hovered) continue;
 
-			if (IsMouseOnCubicBezier(bezier, curr_frame.mouse.pos, selection_threshold))
+			const ConnectionRenderingInfo& info = GetConnectionInfo(connections[int(position)]);
+			if (GetDistanceToCubicBezier(mouse_pos, info.bezier, info.polyline) < selection_threshold)
 			{
-				hovered = i;
+				hovered = position;
 			}
 		}
 
@@ -469,25 +829,17 @@ namespace board
 
 		if (curr_frame.hovering.connection > 0)
 		{
-			auto& connection = container.connections[curr_frame.hovering.connection];
-
-			std::size_t start_idx = connection.from;
-			std::size_t end_idx = connection.to;
-
-			ImVec2 start_p = GetRectCenter(posts_info[start_idx].total_rect);
-			ImVec2 end_p = GetRectCenter(posts_info[end_idx].total_rect);
+			auto& connection = connections[curr_frame.hovering.connection];
 
 			draw_list->ChannelsSetCurrent(0);
 
-			CubicBezier bezier = GetCubicBezier(start_p, end_p);
-
-			DrawCubicBezier(bezier, colors.ArrayToImColor(colors.selected_connection), selected_connection_thickness);
+			DrawPolyline(GetConnectionInfo(connection).polyline, origin, zoom, polyline_scratch, colors.ArrayToImColor(colors.selected_connection), selected_connection_thickness);
 		}
 
 		if (curr_frame.new_connection.creating)
 		{
-			auto& post_rect = posts_info[curr_frame.new_connection.from].total_rect;
-			ImVec2 from = GetRectCenter(post_rect);
+			auto& post_rect = GetRenderingInfo(curr_frame.new_connection.from).total_rect;
+			ImVec2 from = GetRectCenter(post_rect) * zoom + origin;
 			ImVec2 to = curr_frame.mouse.pos;
 
 			draw_list->ChannelsSetCurrent(1);
@@ -499,31 +851,103 @@ namespace board
 		}
 	}
 
+	void BoardTab::RenderLoading()
+	{
+		if (loader->Done())
+		{
+			try
+			{
+				container = loader->Take();
+			}
+			catch (const std::exception& e)
+			{
+				std::stringstream stream;
+				stream << "Error creating new Tab: " << e.what() << '\n';
+				CommandQueue::CreateErrorWindow(stream.str());
+				is_open = false;
+			}
+			loader.reset();
+			return;
+		}
+
+		ImGui::Text("Loading %s", loader->Path().c_str());
+		ImGui::ProgressBar(loader->Progress());
+	}
+
+	bool BoardTab::NeedsRedraw() const
+	{
+		if (loader) return true; // Polled every frame, and the progress bar moves
+		if (curr_frame.mouse.dragging_post) return true;
+		if (requested_zoom > 0.f) return true;
+		// Layout that only catches up on the next frame
+		return connection_tree_dirty || !moved_posts.empty() || post_grid.size() != container.size();
+	}
+
 	void BoardTab::Render()
 	{
 		CommandQueueLookup();
 
+		if (loader)
+		{
+			RenderLoading();
+			return;
+		}
+
 		BoardColors& color_table = container.board_options.color_table;
 
 		ImGui::PushStyleColor(ImGuiCol_ChildBg, BoardColors::ArrayToImColor(color_table.bg).operator ImVec4());
 		
 		ImGui::BeginChild("active tab", ImVec2(0, 0), false, TabChildWindowFlags);
 		
+		ImGui::SetWindowFontScale(1.f); // Last frame's zoom is still applied to the window
 		s_unit = ImGui::GetFontSize();
 		ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
 		const float current_scroll_x = ImGui::GetScrollMaxX();
 		const float current_scroll_y = ImGui::GetScrollMaxY();
 
-		if (current_scroll_x != last_frame_info.scroll_max_x) ImGui::SetScrollX(current_scroll_x);
-		if (current_scroll_y != last_frame_info.scroll_max_y) ImGui::SetScrollY(current_scroll_y);
+		if (!last_frame_info.zoomed)
+		{
+			if (current_scroll_x != last_frame_info.scroll_max_x) ImGui::SetScrollX(current_scroll_x);
+			if (current_scroll_y != last_frame_info.scroll_max_y) ImGui::SetScrollY(current_scroll_y);
+		}
 
 		PopulateCurrentFrameInfo();
+
+		const ImGuiIO& io = ImGui::GetIO();
+		bool zoomed = false;
+		if (io.KeyCtrl && io.MouseWheel != 0.f && ImGui::IsWindowHovered())
+		{
+			zoomed = ZoomAround(zoom * std::pow(camera.zoom_step, io.MouseWheel), curr_frame.mouse.pos);
+		}
+		if (requested_zoom > 0.f)
+		{
+			zoomed |= ZoomAround(requested_zoom, ImGui::GetWindowPos() + ImGui::GetWindowSize() * 0.5f);
+			requested_zoom = 0.f;
+		}
+		detail = (zoom < camera.rects_below ? Detail::rects : (zoom < camera.titles_below ? Detail::titles : Detail::full));
+
+		const float tessellation = std::exp2(std::round(std::log2(zoom)));
+		if (tessellation != tessellation_zoom)
+		{
+			tessellation_zoom = tessellation;
+			connection_tree_dirty = true; // Every polyline is tessellated again
+		}
+
+		curr_frame.board_origin = ImGui::GetWindowPos() - ImVec2(ImGui::GetScrollX(), ImGui::GetScrollY());
 		
 		if (curr_frame.mouse.dragging_post && curr_frame.mouse.released)
 		{
 			curr_frame.mouse.dragging_post = false;
 			curr_frame.just_released_post = true;
+			connection_tree_dirty = true; // Refitting while dragging loosens the tree
+			history.EndContinuousEdit();
+		}
+
+		if (io.KeyCtrl && !io.WantTextInput) // Text widgets handle their own undo
+		{
+			if (ImGui::IsKeyPressed(ImGuiKey_Z)) StepHistory(io.KeyShift);
+			else if (ImGui::IsKeyPressed(ImGuiKey_Y)) StepHistory(true);
 		}
 
 		if (ImGui::IsMouseDragging(0) && ImGui::IsWindowFocused())
@@ -539,15 +963,16 @@ namespace board
 		*/
 		draw_list->ChannelsSetCurrent(2);
 
-		for (std::size_t i = 1; i <= container.size(); i++)
-		{
-			Post& post = container[i];
-			RenderPost(post);
-		}
+		ImGui::SetWindowFontScale(zoom);
+		RenderVisiblePosts();
+		ImGui::SetWindowFontScale(1.f); // Popups opened from this window would inherit it
+		FindHoveredPost();
 
 		RenderConnections();
 
+		BOARD_PROFILE_SCOPE(ChannelsMerge);
 		draw_list->ChannelsMerge();
+		BOARD_PROFILE_END(ChannelsMerge);
 
 		#ifdef BOARD_DEBUG
 		ShowDebugWindow();
@@ -558,12 +983,12 @@ namespace board
 		{
 			if (!ImGui::IsPopupOpen("right click on post"))
 			{
-				curr_frame.selections.rightclicked = 0;
+				curr_frame.selections.rightclicked = PostID();
 			}
 
 			if (curr_frame.new_connection.creating)
 			{
-				if (curr_frame.hovering.post == 0 || curr_frame.new_connection.from == curr_frame.hovering.post)
+				if (curr_frame.hovering.post.IsNull() || curr_frame.new_connection.from == curr_frame.hovering.post)
 				{
 					curr_frame.new_connection.Reset();
 				}
@@ -571,7 +996,9 @@ namespace board
 				{
 					curr_frame.new_connection.to = curr_frame.hovering.post;
 
-					container.connections.EmplaceBack(curr_frame.new_connection.from, curr_frame.new_connection.to);
+					EndEditPostGroup();
+					history.Connect(container, curr_frame.new_connection.from, curr_frame.new_connection.to); // Refuses duplicates
+					connection_tree_dirty = true;
 
 					curr_frame.new_connection.Reset();
 				}
@@ -584,24 +1011,26 @@ namespace board
 			
 		}
 
-		if (curr_frame.mouse.doubleclicked && curr_frame.selections.leftclicked > 0)
+		if (curr_frame.mouse.doubleclicked && !curr_frame.selections.leftclicked.IsNull())
 		{
-			StartEditingPost(container[curr_frame.selections.leftclicked], posts_info[curr_frame.selections.leftclicked].content_rects, curr_frame.mouse.pos);
+			EndEditPostGroup(); // Typing into the Post is not part of the window's edits
+			StartEditingPost(container[curr_frame.selections.leftclicked], GetRenderingInfo(curr_frame.selections.leftclicked).content_rects, ToBoard(curr_frame.mouse.pos));
 		}
 
+		BOARD_PROFILE_SCOPE(Popups);
 		if (curr_frame.mouse.rightclicked)
 		{
 			if (curr_frame.new_connection.creating)
 			{
 				curr_frame.new_connection.Reset();
 			}
-			if (curr_frame.hovering.post > 0)
+			if (!curr_frame.hovering.post.IsNull())
 			{
 				if (container[curr_frame.hovering.post].editing_content == 0)
 				{
 					curr_frame.selections.rightclicked = curr_frame.hovering.post;
 					ImGui::OpenPopup("right click on post");
-					curr_frame.popups.editing_post.SetOpen(false);
+					CloseEditPostPopup(true);
 				}
 				
 			}
@@ -617,10 +1046,18 @@ namespace board
 
 		if (ImGui::BeginPopup("right click on connection"))
 		{
-			if (ImGui::MenuItem("Remove connection"))
+			// An undo or redo may have taken the connection away since the popup was opened
+			const bool has_connection = curr_frame.hovering.connection > 0 && curr_frame.hovering.connection <= container.GetConnections().size();
+			if (!has_connection)
 			{
-				auto to_remove = container.connections.IteratorFromIndex(curr_frame.hovering.connection);
-				container.connections.Erase(to_remove);
+				ImGui::CloseCurrentPopup();
+			}
+			else if (ImGui::MenuItem("Remove connection"))
+			{
+				const auto to_remove = container.GetConnections()[curr_frame.hovering.connection];
+				EndEditPostGroup();
+				history.Disconnect(container, to_remove.from, to_remove.to);
+				connection_tree_dirty = true;
 				curr_frame.hovering.connection = 0;
 			}
 			ImGui::EndPopup();
@@ -632,13 +1069,15 @@ namespace board
 
 		if (ImGui::BeginPopup("right click on blank"))
 		{
-			const ImVec2 mouse_pos = ImGui::GetMousePosOnOpeningCurrentPopup();
+			const ImVec2 mouse_pos = ToBoard(ImGui::GetMousePosOnOpeningCurrentPopup());
 
 			if (ImGui::MenuItem("Add Post"))
 			{
-				Post& new_post = *container.CreatePostBack();
+				Post new_post;
 				new_post.display_pos = { mouse_pos.x, mouse_pos.y };
-				curr_frame.selections.leftclicked = 0;
+				EndEditPostGroup();
+				history.CreatePost(container, std::move(new_post));
+				curr_frame.selections.leftclicked = PostID();
 			}
 			ImGui::EndPopup();
 		}
@@ -646,20 +1085,31 @@ namespace board
 		if (ImGui::BeginPopup("right click on post"))
 		{
 			const ImVec2 mouse_pos = ImGui::GetMousePosOnOpeningCurrentPopup();
-			Post& post = container[curr_frame.selections.rightclicked];
 
-			if (ImGui::MenuItem("Edit Post"))
+			// An undo or redo may have taken the Post away since the popup was opened
+			if (!container.Contains(curr_frame.selections.rightclicked))
 			{
+				ImGui::CloseCurrentPopup();
+			}
+			else if (ImGui::MenuItem("Edit Post"))
+			{
+				if (container.Contains(curr_frame.selections.leftclicked))
+				{
+					container[curr_frame.selections.leftclicked].editing_content = 0; // So the window's edits can be grouped right away
+				}
+				history.EndContinuousEdit();
 				curr_frame.popups.editing_post.SetOpen(true);
 			}
-
-			if (ImGui::MenuItem("Remove Post"))
+			else if (ImGui::MenuItem("Remove Post"))
 			{// TODO: confirmation of deletion
-				container.Erase(container.IteratorFromIndex(curr_frame.selections.rightclicked));
-				curr_frame.selections.rightclicked = 0;
-				curr_frame.selections.leftclicked = 0;
+				post_grid.Remove(curr_frame.selections.rightclicked);
+				EndEditPostGroup();
+				history.ErasePost(container, curr_frame.selections.rightclicked);
+				connection_tree_dirty = true;
+				curr_frame.selections.rightclicked = PostID();
+				curr_frame.selections.leftclicked = PostID();
 			}
-			if (ImGui::MenuItem("Connect to..."))
+			else if (ImGui::MenuItem("Connect to..."))
 			{
 				curr_frame.new_connection.creating = true;
 				curr_frame.new_connection.from = curr_frame.selections.rightclicked;
@@ -679,19 +1129,24 @@ namespace board
 			
 			bool open = true;
 
-			if (curr_frame.selections.rightclicked == 0)
+			if (!container.Contains(curr_frame.selections.rightclicked))
 			{
-				vars.SetOpen(false);
+				CloseEditPostPopup(true);
 			}
 			else
 			{
-				Post& post = container[curr_frame.selections.rightclicked];
+				const PostID id = curr_frame.selections.rightclicked;
+				Post& post = container[id];
 
 				bool default_color = !post.HasColor();
 
-				if (vars.NeedsRefresh())
+				// Text typed into a Post on the board is not part of the window's edits, the group waits until that stops
+				const PostID on_board = curr_frame.selections.leftclicked;
+				const bool editing_on_board = container.Contains(on_board) && container[on_board].editing_content != 0;
+				if (!vars.Recording() && !editing_on_board)
 				{
-					vars.Refresh(post);
+					history.BeginGroup();
+					vars.SetRecording(true);
 				}
 
 				ImGui::Begin("Edit post", &open, PopupWindowFlags);
@@ -701,14 +1156,15 @@ namespace board
 
 				ImGui::BeginGroup();
 
-				for (auto& content : post.content)
+				for (std::size_t i = 1; i <= post.content.size(); i++)
 				{
+					auto& content = post.content[i];
 					switch (content.GetType())
 					{
 					case ContentType::text:
 						ImGui::PushID((void*)&content.AsString());
 
-						ImGui::InputTextMultiline("", &content.AsString());
+						InputTextRecorded(history, container, id, i);
 
 						ImGui::PopID();
 						break;
@@ -725,15 +1181,12 @@ namespace board
 				{
 					if (!default_color)
 					{
-						post.color[0] = color_table.RGBIntToFloat(84);
-						post.color[1] = color_table.RGBIntToFloat(84);
-						post.color[2] = color_table.RGBIntToFloat(84);
+						const float gray = color_table.RGBIntToFloat(84);
+						history.SetColor(container, id, { gray, gray, gray });
 					}
 					else
 					{
-						post.color[0] = -1.f;
-						post.color[1] = -1.f;
-						post.color[2] = -1.f;
+						history.SetColor(container, id, { -1.f, -1.f, -1.f });
 					}
 				}
 
@@ -755,7 +1208,11 @@ namespace board
 					flags |= ImGuiColorEditFlags_DisplayRGB;
 				}
 
-				ImGui::ColorPicker3("", post.color, flags);
+				float picked[3] = { post.color[0], post.color[1], post.color[2] };
+				if (ImGui::ColorPicker3("", picked, flags))
+				{
+					history.SetColor(container, id, picked);
+				}
 				ImGui::PopID();
 
 
@@ -776,9 +1233,7 @@ namespace board
 					const ImGuiColorEditFlags flags = ImGuiColorEditFlags_NoAlpha | ImGuiColorEditFlags_NoPicker | ImGuiColorEditFlags_NoTooltip;
 					if (ImGui::ColorButton("##palette", palette[n], flags, color_size))
 					{
-						post.color[0] = palette[n].x;
-						post.color[1] = palette[n].y;
-						post.color[2] = palette[n].z;
+						history.SetColor(container, id, { palette[n].x, palette[n].y, palette[n].z });
 					}
 					ImGui::PopID();
 				}
@@ -800,20 +1255,18 @@ namespace board
 
 				if (ImGui::Button("Cancel", cancel_size))
 				{
-					post = vars.CachedPost();
-					vars.SetOpen(false);
+					CloseEditPostPopup(false);
 				}
 				ImGui::SameLine();
 
 				if (ImGui::Button("OK", cancel_size))
 				{
-					vars.SetOpen(false);
+					CloseEditPostPopup(true);
 				}
 
 				if (!open)
 				{
-					post = vars.CachedPost();
-					vars.SetOpen(false); 
+					CloseEditPostPopup(false);
 				}
 
 				ImGui::End();
@@ -825,10 +1278,12 @@ namespace board
 		{
 			ShowBoardOptions(container.board_options, &curr_frame.popups.table_options.open);
 		}
+		BOARD_PROFILE_END(Popups);
 
 		last_frame_info.scroll_max_x = ImGui::GetScrollMaxX();
 		last_frame_info.scroll_max_y = ImGui::GetScrollMaxY();
 		last_frame_info.content_size = ImGui::GetWindowContentRegionMax();
+		last_frame_info.zoomed = zoomed;
 
 		ImGui::EndChild();
 		ImGui::PopStyleColor();
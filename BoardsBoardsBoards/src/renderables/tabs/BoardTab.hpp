@@ -1,14 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <memory>
 #include <optional> 
+#include <unordered_map>
+#include <vector>
 
 #include "imgui_internal.h" // ImRect
 
 #include "renderables/Widget.hpp"
 #include "renderables/posts/Post.hpp"
 #include "containers/PostContainer.hpp"
+#include "containers/EditHistory.hpp"
+#include "containers/SpatialGrid.hpp"
+#include "containers/BoundingVolumeHierarchy.hpp"
+#include "utils/Bezier.hpp"
 #include "utils/FilePath.hpp"
+#include "utils/parsing/BoardLoader.hpp"
 
 namespace board
 {
@@ -22,8 +31,30 @@ namespace board
         BoardTab(string unique_ID);
         BoardTab(PostContainer&& container, string path);
         BoardTab(const PostContainer& container, string path);
+        BoardTab(std::unique_ptr<utils::BoardLoader> loader); // Shows a placeholder until the loader is done
         void Render();
 
+        bool IsLoading() const { return loader != nullptr; }
+        bool CanUndo() const { return history.CanUndo(); }
+        bool CanRedo() const { return history.CanRedo(); }
+        bool NeedsRedraw() const; // True if the next frame would differ even without input
+
+        // Posts keep their size in board units, the units of Post::display_pos; the view shows the board scaled by
+        // the zoom and scrolled. Ctrl + mouse wheel zooms around the mouse.
+        struct Camera
+        {
+            float min_zoom = 0.05f;
+            float max_zoom = 4.f;
+            float zoom_step = 1.1f; // Per notch of the mouse wheel
+
+            // Levels of detail: as the board gets smaller on screen, Posts get cheaper to draw
+            float titles_below = 0.6f; // Only the first line of the first content
+            float rects_below = 0.3f; // Only the colored rectangles
+        }camera;
+
+        float GetZoom() const { return zoom; }
+        void SetZoom(float new_zoom); // Applied on the next frame, around the center of the view
+
         PostContainer container;
         
         enum class status { unnamed_file, fromdisk, fromdisk_modified };
@@ -37,8 +68,9 @@ namespace board
         struct CurrentFrameInfo
         {
             
-            std::size_t just_selected_post = 0;
+            PostID just_selected_post;
             bool just_released_post = false;
+            ImVec2 board_origin = ImVec2(); // Screen position of the board's (0, 0)
 
             struct Mouse
             {
@@ -63,12 +95,12 @@ namespace board
             struct Hovering
             {
                 std::size_t connection = 0;
-                std::size_t post = 0;
+                PostID post;
 
                 
                 void Reset()
                 {
-                    post = 0;
+                    post = PostID();
                 }
                 
 
@@ -80,23 +112,12 @@ namespace board
                 {
                 public:
                     bool Open() { return open; }
-                    bool NeedsRefresh() { return cache_needs_refresh; }
-                    void WillRefresh(bool var) { cache_needs_refresh = var; }
-                    void Refresh(const Post& to_cache)
-                    {
-                        cached_post.emplace(to_cache);
-                        WillRefresh(false);
-                    }
-                    void SetOpen(bool var)
-                    {
-                        WillRefresh(true);
-                        open = var;
-                    }
-                    const Post& CachedPost() { return *cached_post; }
+                    void SetOpen(bool var) { open = var; }
+                    bool Recording() { return recording; }
+                    void SetRecording(bool var) { recording = var; }
                 private:
                     bool open = false;
-                    bool cache_needs_refresh = true;
-                    std::optional<Post> cached_post;
+                    bool recording = false; // Edits made in the popup form one history group, so Cancel can undo them
                 }editing_post;
 
                 struct TableOptions
@@ -108,21 +129,21 @@ namespace board
 
             struct Selections
             {
-                std::size_t leftclicked = 0;
-                std::size_t rightclicked = 0;
+                PostID leftclicked;
+                PostID rightclicked;
                 
             }selections;
 
             struct NewConnection
             {
                 bool creating = false;
-                std::size_t from = 0;
-                std::size_t to = 0;
+                PostID from;
+                PostID to;
 
                 void Reset()
                 {
                     creating = false;
-                    from = to = 0;
+                    from = to = PostID();
                 }
             }new_connection;
 
@@ -131,33 +152,112 @@ namespace board
                 mouse.Reset();
                 hovering.Reset();
                 just_released_post = false;
-                just_selected_post = 0;
+                just_selected_post = PostID();
             }
         }curr_frame;
 
         
         void PopulateCurrentFrameInfo();
-        void RenderPost(Post& post);
+        bool ZoomAround(float new_zoom, const ImVec2& anchor); // The board position under the screen position anchor stays there. Returns true if the zoom changed
+        ImVec2 ToBoard(const ImVec2& screen_pos) const;
+        ImRect ToScreen(const ImRect& board_rect) const;
+        void RenderPost(PostID id);
+        void RenderVisiblePosts();
+        void FindHoveredPost();
         void RenderConnections();
+        void UpdateConnectionTree();
         void ShowDebugWindow();
         void CommandQueueLookup();
+        void RenderLoading();
      
-        float s_unit; // Short for "screen unit". ImGui::GetFontSize() at the start of every frame
+        float s_unit; // Short for "screen unit". ImGui::GetFontSize() at the start of every frame, before the zoom
 
-        void SetSelectedPost(std::size_t idx);
+        float zoom = 1.f;
+        float requested_zoom = 0.f; // Set by SetZoom, 0 if there is none
+
+        enum class Detail { full, titles, rects };
+        Detail detail = Detail::full; // For the current zoom, the Post being edited is always drawn in full
+
+        void SetSelectedPost(PostID id);
         void DragSelectedPost();
+        void CloseEditPostPopup(bool keep_edits);
+        void EndEditPostGroup(); // Called before any edit made outside of the "Edit post" window, so its Cancel never reverts it
+        void StepHistory(bool redo);
+        void DropLayoutCaches(); // After the history changed the board behind the caches' back
+
+        EditHistory history; // Every edit to container goes through it
+
+        // Text of one PostContent as ImGui would lay it out at zoom 1
+        struct TextLayout
+        {
+            // What it was measured for, it is only measured again when the text is edited or the font changes
+            std::uint64_t revision = 0; // PostContent::GetRevision(), 0 if it was never measured
+            const ImFont* font = nullptr;
+            float font_size = 0.f;
+
+            ImVec2 size = ImVec2(); // Rounded as ImGui::CalcTextSize does
+            // Offset of every '\n'. Post text is never wrapped, so the lines between them are its only glyph runs.
+            // Glyph offsets inside a line are not kept: ImDrawList::AddText cannot take them, and ImFont::RenderText
+            // already sums the same AdvanceX table while it writes the vertices.
+            std::vector<std::uint32_t> line_breaks;
+        };
 
         struct PostRenderingInfo
         {
-            ImRect total_rect;
+            PostID id; // Post this info was last filled for, slots are reused after an erase
+            ImRect total_rect; // In board units, so it stays valid while the Post is culled or the zoom changes
             
+            // In board units, sized by LayoutPost before any content is looked up
             // pair.first = displaying rectangle
             // pair.second = editing rectangle
 
-            LuaVector<std::pair<ImRect, ImRect>> content_rects = LuaVector<std::pair<ImRect, ImRect>>(true);
+            LuaVector<std::pair<ImRect, ImRect>, LuaVectorAccess::unchecked> content_rects;
+            LuaVector<TextLayout, LuaVectorAccess::unchecked> text_layouts; // One per content
+
+            // What the rectangles were placed for, see PlacePost
+            float placed_font_size = 0.f;
+            std::pair<float, float> placed_pos;
+            std::size_t placed_contents = 0;
+            std::size_t placed_editing = 0;
+        };
+
+        // Indexed by PostID::slot + 1
+        LuaVector<PostRenderingInfo, LuaVectorAccess::growing> posts_info;
+        PostRenderingInfo& GetRenderingInfo(PostID id);
+        bool MeasureText(const PostContent& content, TextLayout& layout) const; // Returns true if it had to be measured again
+        void PlacePost(const Post& post, PostRenderingInfo& info) const;
+        PostRenderingInfo& LayoutPost(PostID id); // Updates the rectangles from the cached text layouts
+
+        // Hit rectangles of every laid out Post, in board units so scrolling and zooming do not move them
+        SpatialGrid post_grid;
+        std::vector<PostID> grid_results;
+        std::vector<PostID> visible_posts;
+        ImVec2 content_max = ImVec2(); // Furthest corner reached by any laid out Post, keeps the scrolling area while Posts are culled
+
+        struct ConnectionRenderingInfo
+        {
+            utils::CubicBezier bezier; // In board units, runs between the centers of both Posts
+            std::vector<ImVec2> polyline;
+            float tessellation_zoom = 0.f; // Value of tessellation_zoom when polyline was built
+            ImRect bounds;
+            std::size_t position = 0; // Position inside GetConnections() when connection_tree was built
+            std::uint64_t tree_build = 0; // Value of tree_builds when the connection was placed in connection_tree
         };
 
-        LuaVector<PostRenderingInfo> posts_info = LuaVector<PostRenderingInfo>(true);
+        // Tessellated connections, only rebuilt when one of their Posts moves
+        std::unordered_map<PostContainer::PostConnection, ConnectionRenderingInfo, PostContainer::ConnectionHash> connections_info;
+        ConnectionRenderingInfo& GetConnectionInfo(const PostContainer::PostConnection& connection);
+        std::vector<ImVec2> polyline_scratch;
+        // Connections are tessellated for the power of two closest to the zoom, so they stay smooth when zooming in
+        float tessellation_zoom = 1.f;
+
+        // Bounds of every connection, item i is the connection at position i + 1
+        BoundingVolumeHierarchy connection_tree;
+        bool connection_tree_dirty = true; // Set when connections are added or removed
+        std::uint64_t tree_builds = 0;
+        std::vector<ImRect> tree_bounds;
+        std::vector<std::size_t> tree_results;
+        std::vector<PostID> moved_posts; // Posts whose rectangle changed since connection_tree was last refit
 
         struct LastFrameInfo
         {
@@ -165,11 +265,14 @@ namespace board
             float scroll_max_y = 0;
 
             ImVec2 content_size = ImVec2();
+            bool zoomed = false; // The scrolling area changed because of the zoom, the scroll was already placed
             void Reset() 
             {
                 scroll_max_x = scroll_max_y = 0; 
             }
 
         }last_frame_info;      
+
+        std::unique_ptr<utils::BoardLoader> loader; // Parsing the board on another thread, null once container holds it
     };
 }
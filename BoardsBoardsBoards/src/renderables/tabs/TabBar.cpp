@@ -2,18 +2,19 @@
 
 #include <sstream>
 #include <format>
+#include <memory>
 #include <unordered_map>
 
 #include "imgui.h"
 
 #include "containers/PostContainer.hpp"
 #include "utils/LuaStack.hpp"
-#include "utils/parsing/BoardParser.hpp"
+#include "utils/parsing/BoardLoader.hpp"
 #include "renderables/DearImGuiFlags.hpp"
 #include "utils/CommandQueue.hpp"
 
 using utils::LuaStack;
-using utils::BoardParser;
+using utils::BoardLoader;
 
 namespace board
 {
@@ -48,32 +49,37 @@ namespace board
         }
     }
 
-    void TabBar::NewBoardTab(const std::string& path)
+    void TabBar::AddLoadingTab(const std::string& path)
     {
-        try
+        for (std::size_t i = 0; i < tabs.size(); i++)
         {
-            for (std::size_t i = 0; i < tabs.size(); i++)
+            auto& tab = tabs[i];
+            if (tab.path.GetFullPath() == path)
             {
-                auto& tab = tabs[i];
-                if (tab.path.GetFullPath() == path)
-                {
-                    change_to = i;
-                    return;
-                }
+                change_to = i;
+                return;
             }
-            sol::table t = LuaStack::TableFromFile(path);
-            PostContainer container = BoardParser().Parse(t);
-            BoardTab new_tab(std::move(container), path);
-            tabs.push_back(std::move(new_tab));
-
-            EnforceNoRepeatedTabNames();
         }
-        catch (const std::exception& e)
+        // Parsed by the shared WorkerPool, the tab shows its progress until the board is ready
+        tabs.emplace_back(std::make_unique<BoardLoader>(path));
+    }
+
+    void TabBar::NewBoardTabs(const std::vector<std::string>& paths)
+    {
+        for (const std::string& path : paths)
         {
-            std::stringstream stream;
-            stream << "Error creating new Tab: " << e.what() << '\n';
-            CommandQueue::CreateErrorWindow(stream.str());
+            try
+            {
+                AddLoadingTab(path);
+            }
+            catch (const std::exception& e)
+            {
+                std::stringstream stream;
+                stream << "Error creating new Tab: " << e.what() << '\n';
+                CommandQueue::CreateErrorWindow(stream.str());
+            }
         }
+        EnforceNoRepeatedTabNames();
     }
 	void TabBar::NewBoardTab()
 	{
@@ -90,6 +96,12 @@ namespace board
         }
 	}
 
+    bool TabBar::NeedsRedraw() const
+    {
+        // Only the active tab is rendered; tabs may have been closed since active_tab was set
+        return active_tab >= 0 && active_tab < int(tabs.size()) && tabs[active_tab].NeedsRedraw();
+    }
+
     void TabBar::Render()
     {
         if (ImGui::BeginTabBar("Main Tab Bar", TabBarFlags))
@@ -17,7 +17,8 @@ namespace board
 		void Render() override;
 	private:
 		void NewBoardTab();
-		void NewBoardTab(const std::string& path);
+		void NewBoardTabs(const std::vector<std::string>& paths); // Loaded in parallel, the tabs keep the order of paths
+		void AddLoadingTab(const std::string& path);
 
 		void EnforceNoRepeatedTabNames(bool first_run = true);
 
@@ -26,6 +27,7 @@ namespace board
 		std::vector<BoardIt> to_delete;
 
 		bool hasActiveTab() { return active_tab >= 0; }
+		bool NeedsRedraw() const;
 
 		// - Will throw if !hasActiveTab()
 		BoardTab& getActiveTab()
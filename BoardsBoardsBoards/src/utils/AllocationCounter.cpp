@@ -0,0 +1,62 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib> // std::malloc, std::free
+#include <new>
+
+namespace utils
+{
+	void* AllocationCounter::CountedMalloc(std::size_t size, void*)
+	{
+		Count();
+		return std::malloc(size);
+	}
+
+	void AllocationCounter::CountedFree(void* ptr, void*)
+	{
+		std::free(ptr);
+	}
+}
+
+#ifdef BOARD_COUNTING_ALLOCATIONS
+
+// The default nothrow forms call these. Aligned allocations keep the default functions and are not counted.
+
+void* operator new(std::size_t size)
+{
+	utils::AllocationCounter::Count();
+	if (size == 0) size = 1;
+	while (true)
+	{
+		if (void* ptr = std::malloc(size)) return ptr;
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr) throw std::bad_alloc();
+		handler();
+	}
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// The global operator new is only replaced in Debug builds, in Release builds when BOARD_PROFILE is defined (premake5 --profile),
+// and in projects that define BOARD_COUNT_ALLOCATIONS, like Tests. Shipping builds keep the default allocator.
+// Otherwise every count stays at 0.
+#if defined(BOARD_DEBUG) || defined(BOARD_PROFILE) || defined(BOARD_COUNT_ALLOCATIONS)
+#define BOARD_COUNTING_ALLOCATIONS
+#endif
+
+namespace utils
+{
+	// Counts the heap allocations made by each thread.
+	// The hook is the replacement of the global operator new in AllocationCounter.cpp, so it is active in every binary linking that file.
+	// ImGui allocates with malloc unless it is handed CountedMalloc and CountedFree through ImGui::SetAllocatorFunctions.
+	class AllocationCounter
+	{
+	public:
+		static void Count() { this_thread++; }
+		static std::uint64_t ThisThread() { return this_thread; } // Allocations made by the calling thread so far
+
+		// Called by the UI thread after every frame
+		static void EndFrame()
+		{
+			last_frame = this_thread - frame_start;
+			frame_start = this_thread;
+		}
+		static std::uint64_t LastFrame() { return last_frame; } // Allocations made by the UI thread during the last whole frame
+
+		static void* CountedMalloc(std::size_t size, void* user_data);
+		static void CountedFree(void* ptr, void* user_data);
+
+	private:
+		static inline thread_local std::uint64_t this_thread = 0;
+		static inline std::uint64_t frame_start = 0;
+		static inline std::uint64_t last_frame = 0;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "imgui.h"
 #include "imgui_internal.h" 
 
@@ -16,7 +18,17 @@ namespace utils
 		int    NumSegments;
 	};
 
-	inline CubicBezier GetCubicBezier(ImVec2 start, ImVec2 end, const float line_segments_per_length = 5)
+	// Wang's formula: the fewest uniform segments that keep the polyline within 'tolerance' pixels of the curve
+	inline int GetCubicBezierSegments(const CubicBezier& b, float tolerance, int max_segments)
+	{
+		const ImVec2 d1 = b.P0 - b.P1 * 2.f + b.P2;
+		const ImVec2 d2 = b.P1 - b.P2 * 2.f + b.P3;
+		const float m = ImSqrt(ImMax(ImLengthSqr(d1), ImLengthSqr(d2)));
+		const int segments = static_cast<int>(ImCeil(ImSqrt(0.75f * m / tolerance)));
+		return ImClamp(segments, 1, max_segments);
+	}
+
+	inline CubicBezier GetCubicBezier(ImVec2 start, ImVec2 end, const float tolerance = 0.25f, const int max_segments = 128)
 	{
 		const float link_length = ImSqrt(ImLengthSqr(end - start));
 		const ImVec2 offset = ImVec2(0.25f * link_length, 0.f);
@@ -25,7 +37,7 @@ namespace utils
 		cubic_bezier.P1 = start + offset;
 		cubic_bezier.P2 = end - offset;
 		cubic_bezier.P3 = end;
-		cubic_bezier.NumSegments = ImMax(static_cast<int>(link_length * line_segments_per_length), 1);
+		cubic_bezier.NumSegments = GetCubicBezierSegments(cubic_bezier, tolerance, max_segments);
 		return cubic_bezier;
 	}
 
@@ -48,7 +60,19 @@ namespace utils
 			b0 * P0.y + b1 * P1.y + b2 * P2.y + b3 * P3.y);
 	}
 
-	ImVec2 GetClosestPointOnCubicBezier(const int num_segments, const ImVec2& p, const CubicBezier& cb)
+	inline ImVec2 EvalCubicBezierDerivative(const float t, const CubicBezier& b)
+	{
+		const float u = 1.0f - t;
+		return (b.P1 - b.P0) * (3 * u * u) + (b.P2 - b.P1) * (6 * u * t) + (b.P3 - b.P2) * (3 * t * t);
+	}
+
+	inline ImVec2 EvalCubicBezierSecondDerivative(const float t, const CubicBezier& b)
+	{
+		const float u = 1.0f - t;
+		return (b.P2 - b.P1 * 2.f + b.P0) * (6 * u) + (b.P3 - b.P2 * 2.f + b.P1) * (6 * t);
+	}
+
+	inline ImVec2 GetClosestPointOnCubicBezier(const int num_segments, const ImVec2& p, const CubicBezier& cb)
 	{
 		ImVec2 p_last = cb.P0;
 		ImVec2 p_closest;
@@ -93,13 +117,102 @@ namespace utils
 		return ImSqrt(ImLengthSqr(to_curve));
 	}
 
+	// Fills 'points' with NumSegments + 1 points along the curve, reusing its storage
+	inline void TessellateCubicBezier(const CubicBezier& b, std::vector<ImVec2>& points)
+	{
+		points.clear();
+		const float t_step = 1.0f / (float)b.NumSegments;
+		points.push_back(b.P0);
+		for (int i = 1; i < b.NumSegments; ++i)
+		{
+			points.push_back(EvalCubicBezier(t_step * i, b.P0, b.P1, b.P2, b.P3));
+		}
+		points.push_back(b.P3);
+	}
+
+	inline ImRect GetContainingRectForPolyline(const std::vector<ImVec2>& points, float minimum_distance)
+	{
+		ImRect rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (const ImVec2& p : points)
+		{
+			rect.Add(p);
+		}
+		rect.Expand(minimum_distance);
+		return rect;
+	}
+
+	inline float GetDistanceToPolyline(const ImVec2& pos, const std::vector<ImVec2>& points)
+	{
+		float closest_dist = FLT_MAX;
+		for (std::size_t i = 1; i < points.size(); ++i)
+		{
+			const ImVec2 p_line = ImLineClosestPoint(points[i - 1], points[i], pos);
+			closest_dist = ImMin(closest_dist, ImLengthSqr(pos - p_line));
+		}
+		return ImSqrt(closest_dist);
+	}
+
+	// Distance from pos to the curve itself. 'polyline' is the curve tessellated by TessellateCubicBezier: its closest
+	// segment gives the starting t, which a few Newton steps on (B(t) - pos) . B'(t) = 0 then refine.
+	inline float GetDistanceToCubicBezier(const ImVec2& pos, const CubicBezier& b, const std::vector<ImVec2>& polyline)
+	{
+		if (polyline.size() < 2) return ImSqrt(ImLengthSqr(pos - b.P0));
+
+		std::size_t closest_segment = 1;
+		float closest_dist = FLT_MAX;
+		for (std::size_t i = 1; i < polyline.size(); ++i)
+		{
+			const float dist = ImLengthSqr(pos - ImLineClosestPoint(polyline[i - 1], polyline[i], pos));
+			if (dist < closest_dist)
+			{
+				closest_dist = dist;
+				closest_segment = i;
+			}
+		}
+
+		const ImVec2& a = polyline[closest_segment - 1];
+		const ImVec2 ab = polyline[closest_segment] - a;
+		const float ab_length = ImLengthSqr(ab);
+		const float along = (ab_length > 0.f ? ImSaturate(ImDot(pos - a, ab) / ab_length) : 0.f);
+		const float segments = float(polyline.size() - 1);
+
+		float t = (float(closest_segment - 1) + along) / segments;
+		float best_dist = ImLengthSqr(EvalCubicBezier(t, b.P0, b.P1, b.P2, b.P3) - pos);
+
+		const int max_iterations = 4;
+		for (int i = 0; i < max_iterations; ++i)
+		{
+			const ImVec2 d = EvalCubicBezier(t, b.P0, b.P1, b.P2, b.P3) - pos;
+			const ImVec2 d1 = EvalCubicBezierDerivative(t, b);
+			const ImVec2 d2 = EvalCubicBezierSecondDerivative(t, b);
+			const float slope = ImDot(d1, d1) + ImDot(d, d2);
+			if (ImFabs(slope) < 1e-6f) break;
+
+			t = ImSaturate(t - ImDot(d, d1) / slope);
+			best_dist = ImMin(best_dist, ImLengthSqr(EvalCubicBezier(t, b.P0, b.P1, b.P2, b.P3) - pos));
+		}
+		return ImSqrt(best_dist);
+	}
+
+	// 'points' are drawn scaled by 'scale', then moved by 'offset'; 'scratch' holds the moved copy so no allocation is needed once it has grown
+	inline void DrawPolyline(const std::vector<ImVec2>& points, const ImVec2& offset, float scale, std::vector<ImVec2>& scratch,
+							 ImU32 col = IM_COL32_WHITE, float thickness = 5.f, ImDrawList* draw_list = ImGui::GetWindowDrawList())
+	{
+		scratch.clear();
+		for (const ImVec2& p : points)
+		{
+			scratch.push_back(p * scale + offset);
+		}
+		draw_list->AddPolyline(scratch.data(), static_cast<int>(scratch.size()), col, ImDrawFlags_None, thickness);
+	}
+
 	inline void DrawCubicBezier(const CubicBezier& bezier, ImU32 col = IM_COL32_WHITE, float thickness = 5.f, ImDrawList* draw_list = ImGui::GetWindowDrawList())
 	{
 		draw_list->AddBezierCubic(bezier.P0, bezier.P1, bezier.P2, bezier.P3,
 								  col, thickness, bezier.NumSegments);
 	}
 
-	bool IsMouseOnCubicBezier(const CubicBezier& b, ImVec2& mouse_pos, float minimum_distance)
+	inline bool IsMouseOnCubicBezier(const CubicBezier& b, ImVec2& mouse_pos, float minimum_distance)
 	{
 		const auto connection_rect = GetContainingRectForCubicBezier(b, minimum_distance);
 		if (!connection_rect.Contains(mouse_pos)) return false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm> // std::equal
+#include <cmath> // fmodf
 
 #include "imgui.h"
 
@@ -0,0 +1,290 @@
+#include "BoardGenerator.hpp"
+
+#include <algorithm> // std::max, std::min
+#include <array>
+#include <cmath> // std::ceil, std::cos, std::log, std::sqrt
+#include <random> // std::mt19937
+#include <utility> // std::pair
+#include <vector>
+
+#include "utils/BoardColors.hpp"
+#include "utils/Error.hpp"
+#include "utils/parsing/BoardParser.hpp"
+
+namespace utils
+{
+	using board::Post;
+	using board::PostID;
+
+	namespace
+	{
+		class Random
+		{
+		public:
+			Random(std::uint32_t seed) : engine(seed) {}
+
+			double Unit() { return double(engine()) / 4294967296.0; } // [0, 1)
+			std::size_t Below(std::size_t count) { return std::min(std::size_t(Unit() * double(count)), count - 1); }
+			bool Chance(double probability) { return Unit() < probability; }
+			double Exponential(double mean) { return -mean * std::log(1.0 - Unit()); }
+			double Normal() { return std::sqrt(-2.0 * std::log(1.0 - Unit())) * std::cos(6.283185307179586 * Unit()); }
+
+			// Between 0 and twice mean, mean on average even when it has a fraction
+			std::size_t Around(double mean)
+			{
+				const double value = Unit() * 2.0 * mean;
+				const std::size_t whole = std::size_t(value);
+				return whole + (Chance(value - double(whole)) ? 1 : 0);
+			}
+
+		private:
+			std::mt19937 engine;
+		};
+
+		const std::array<const char*, 24> words =
+		{
+			"board", "post", "idea", "note", "plan", "task", "draft", "review", "link", "quote", "source", "question",
+			"answer", "detail", "summary", "todo", "meeting", "deadline", "sketch", "list", "topic", "reference", "lorem", "ipsum"
+		};
+
+		std::string Line(const BoardGenerator::Options& options, Random& random)
+		{
+			std::size_t length = options.mean_characters;
+			switch (options.content_size)
+			{
+			case BoardGenerator::ContentSize::fixed:
+				break;
+			case BoardGenerator::ContentSize::uniform:
+				length = 1 + random.Below(2 * options.mean_characters);
+				break;
+			case BoardGenerator::ContentSize::long_tail:
+				length = 1 + std::size_t(random.Exponential(double(options.mean_characters - 1) + 0.5));
+				break;
+			}
+
+			std::string line;
+			line.reserve(length + 16);
+			while (line.size() < length)
+			{
+				if (!line.empty()) line += ' ';
+				line += words[random.Below(words.size())];
+			}
+			line.resize(length);
+			return line;
+		}
+
+		LuaValue TagValue(Random& random)
+		{
+			switch (random.Below(4))
+			{
+			case 0: return LuaValue(int(random.Below(1000)));
+			case 1: return LuaValue(float(random.Unit() * 100.0));
+			case 2: return LuaValue(random.Chance(0.5));
+			default: return LuaValue(LuaValue::Variant(std::string(words[random.Below(words.size())])));
+			}
+		}
+
+		Post MakePost(const BoardGenerator::Options& options, Random& random)
+		{
+			std::vector<std::string> lines(options.min_lines + random.Below(options.max_lines - options.min_lines + 1));
+			for (std::string& line : lines) line = Line(options, random);
+			Post post(lines);
+
+			const std::size_t tags = random.Around(options.tags_per_post);
+			for (std::size_t i = 0; i < tags; i++)
+			{
+				board::TagEntryList& values = post.tags["key_" + std::to_string(random.Below(options.tag_keys))];
+				const std::size_t count = 1 + random.Below(3);
+				for (std::size_t value = 0; value < count; value++)
+				{
+					values.PushBack(TagValue(random));
+				}
+			}
+
+			if (random.Chance(options.colored_fraction))
+			{
+				// Eight bits per channel, as the color picker and the Lua format keep them
+				for (float& channel : post.color) channel = BoardColors::RGBIntToFloat(int(random.Below(256)));
+			}
+			return post;
+		}
+
+		std::vector<std::pair<float, float>> Positions(const BoardGenerator::Options& options, Random& random)
+		{
+			const std::size_t count = options.posts;
+			const float side = std::sqrt(float(count)) * options.spacing; // Square that fits every Post at 'spacing'
+
+			std::vector<std::pair<float, float>> positions;
+			positions.reserve(count);
+			switch (options.layout)
+			{
+			case BoardGenerator::Layout::grid:
+			{
+				const std::size_t columns = std::max<std::size_t>(1, std::size_t(std::ceil(std::sqrt(double(count)))));
+				for (std::size_t i = 0; i < count; i++)
+				{
+					positions.emplace_back(float(i % columns) * options.spacing, float(i / columns) * options.spacing);
+				}
+				break;
+			}
+			case BoardGenerator::Layout::random:
+				for (std::size_t i = 0; i < count; i++)
+				{
+					positions.emplace_back(float(random.Unit()) * side, float(random.Unit()) * side);
+				}
+				break;
+			case BoardGenerator::Layout::clustered:
+			{
+				const std::size_t clusters = (count + options.cluster_size - 1) / options.cluster_size;
+				const float spread = options.spacing * std::sqrt(float(options.cluster_size)) / 2.f;
+				std::vector<std::pair<float, float>> centers;
+				for (std::size_t i = 0; i < clusters; i++)
+				{
+					centers.emplace_back(float(random.Unit()) * side, float(random.Unit()) * side);
+				}
+				for (std::size_t i = 0; i < count; i++)
+				{
+					const auto& center = centers[i % clusters];
+					// Board positions start at 0
+					positions.emplace_back(std::max(0.f, center.first + float(random.Normal()) * spread),
+										   std::max(0.f, center.second + float(random.Normal()) * spread));
+				}
+				break;
+			}
+			}
+			return positions;
+		}
+
+		void Connect(PostContainer& container, const std::vector<PostID>& ids, const BoardGenerator::Options& options, Random& random)
+		{
+			const std::size_t count = ids.size();
+			if (count < 2) return;
+
+			switch (options.graph)
+			{
+			case BoardGenerator::Graph::none:
+				break;
+			case BoardGenerator::Graph::random:
+			{
+				const std::size_t wanted = std::size_t(options.connections_per_post * double(count) + 0.5);
+				// Connect refuses duplicates and self connections, so dense graphs need more than one try per connection
+				for (std::size_t made = 0, tries = 0; made < wanted && tries < wanted * 4; tries++)
+				{
+					made += container.Connect(ids[random.Below(count)], ids[random.Below(count)]);
+				}
+				break;
+			}
+			case BoardGenerator::Graph::tree:
+				for (std::size_t i = 1; i < count; i++)
+				{
+					container.Connect(ids[(i - 1) / options.branching], ids[i]);
+				}
+				break;
+			case BoardGenerator::Graph::scale_free:
+			{
+				// Every Post appears once per connection it has plus once for itself, so picking uniformly
+				// from 'ends' picks a Post with a chance proportional to its degree plus one
+				std::vector<std::size_t> ends;
+				ends.reserve(count * (2 + std::size_t(options.connections_per_post * 2.0)));
+				ends.push_back(0);
+				for (std::size_t i = 1; i < count; i++)
+				{
+					const std::size_t connections = std::min(random.Around(options.connections_per_post), i);
+					for (std::size_t c = 0; c < connections; c++)
+					{
+						const std::size_t target = ends[random.Below(ends.size())];
+						if (container.Connect(ids[i], ids[target]))
+						{
+							ends.push_back(i);
+							ends.push_back(target);
+						}
+					}
+					ends.push_back(i);
+				}
+				break;
+			}
+			}
+		}
+
+		void Validate(const BoardGenerator::Options& options)
+		{
+			if (options.min_lines == 0 || options.min_lines > options.max_lines)
+				throw BoardGeneratorError("BoardGenerator: min_lines must be at least 1 and at most max_lines.");
+			if (options.mean_characters == 0)
+				throw BoardGeneratorError("BoardGenerator: mean_characters must be at least 1.");
+			if (options.tags_per_post < 0.0 || (options.tags_per_post > 0.0 && options.tag_keys == 0))
+				throw BoardGeneratorError("BoardGenerator: tags need a non negative tags_per_post and at least one key.");
+			if (options.colored_fraction < 0.0 || options.colored_fraction > 1.0)
+				throw BoardGeneratorError("BoardGenerator: colored_fraction must be between 0 and 1.");
+			if (options.connections_per_post < 0.0 || (options.posts > 0 && options.connections_per_post > double(options.posts - 1)))
+				throw BoardGeneratorError("BoardGenerator: connections_per_post must be between 0 and posts - 1.");
+			if (options.branching == 0)
+				throw BoardGeneratorError("BoardGenerator: branching must be at least 1.");
+			if (!(options.spacing > 0.f) || options.cluster_size == 0)
+				throw BoardGeneratorError("BoardGenerator: spacing and cluster_size must be positive.");
+		}
+	}
+
+	PostContainer BoardGenerator::Generate(const Options& options)
+	{
+		Validate(options);
+
+		// Every part has its own stream, so changing how one is generated does not change the others
+		Random content_random(options.seed);
+		Random layout_random(options.seed ^ 0x9e3779b9u);
+		Random graph_random(options.seed ^ 0x7f4a7c15u);
+
+		const std::vector<std::pair<float, float>> positions = Positions(options, layout_random);
+
+		PostContainer container;
+		std::vector<PostID> ids;
+		ids.reserve(options.posts);
+		for (std::size_t i = 0; i < options.posts; i++)
+		{
+			Post post = MakePost(options, content_random);
+			post.display_pos = positions[i];
+			ids.push_back(container.IDOf(container.Insert(container.end(), std::move(post))));
+		}
+
+		Connect(container, ids, options, graph_random);
+		return container;
+	}
+
+	void BoardGenerator::GenerateFile(const Options& options, const std::string& path)
+	{
+		BoardParser().SavePath(Generate(options), path);
+	}
+
+	static const std::array<const char*, 3> content_size_names = { "fixed", "uniform", "long_tail" };
+	static const std::array<const char*, 4> graph_names = { "none", "random", "tree", "scale_free" };
+	static const std::array<const char*, 3> layout_names = { "grid", "random", "clustered" };
+
+	template<typename Enum, std::size_t N>
+	static Enum FromName(const std::array<const char*, N>& names, const std::string& name, const char* what)
+	{
+		for (std::size_t i = 0; i < N; i++)
+		{
+			if (name == names[i]) return Enum(i);
+		}
+		throw BoardGeneratorError("BoardGenerator: unknown " + std::string(what) + " '" + name + "'.");
+	}
+
+	const char* BoardGenerator::Name(ContentSize content_size) { return content_size_names[std::size_t(content_size)]; }
+	const char* BoardGenerator::Name(Graph graph) { return graph_names[std::size_t(graph)]; }
+	const char* BoardGenerator::Name(Layout layout) { return layout_names[std::size_t(layout)]; }
+
+	BoardGenerator::ContentSize BoardGenerator::ContentSizeFromName(const std::string& name)
+	{
+		return FromName<ContentSize>(content_size_names, name, "content size");
+	}
+
+	BoardGenerator::Graph BoardGenerator::GraphFromName(const std::string& name)
+	{
+		return FromName<Graph>(graph_names, name, "graph");
+	}
+
+	BoardGenerator::Layout BoardGenerator::LayoutFromName(const std::string& name)
+	{
+		return FromName<Layout>(layout_names, name, "layout");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "containers/PostContainer.hpp"
+
+namespace utils
+{
+	using board::PostContainer;
+
+	// Builds boards of any size for stress tests, benchmarks and the headless driver.
+	// The same options and seed give the same board. The random numbers come from std::mt19937, whose sequence is fixed
+	// by the standard, and are shaped by the generator itself since the std distributions differ between standard libraries.
+	class BoardGenerator
+	{
+	public:
+		enum class ContentSize
+		{
+			fixed, // Every line has mean_characters
+			uniform, // Between 1 and twice mean_characters
+			long_tail // Exponential, mostly short lines and a few very long ones
+		};
+		enum class Graph
+		{
+			none,
+			random, // Pairs picked uniformly
+			tree, // Every Post but the first connects to its parent, 'branching' children per Post
+			scale_free // Preferential attachment, a few Posts gather most connections
+		};
+		enum class Layout
+		{
+			grid,
+			random, // Uniform over a square that fits every Post at 'spacing'
+			clustered // Groups of about cluster_size Posts around random centers
+		};
+
+		struct Options
+		{
+			std::uint32_t seed = 1;
+			std::size_t posts = 1000;
+
+			std::size_t min_lines = 1; // Text contents per Post
+			std::size_t max_lines = 2;
+			ContentSize content_size = ContentSize::long_tail;
+			std::size_t mean_characters = 60; // Per line
+
+			double tags_per_post = 1.0; // Mean, the actual count is between 0 and twice it
+			std::size_t tag_keys = 16; // Keys are shared between Posts, so tags repeat
+			double colored_fraction = 0.25; // Posts with a color of their own
+
+			Graph graph = Graph::random;
+			double connections_per_post = 1.0; // Mean outgoing connections, for random and scale_free
+			std::size_t branching = 3; // For tree
+
+			Layout layout = Layout::grid;
+			float spacing = 250.f; // Board units between neighbouring Posts
+			std::size_t cluster_size = 50;
+		};
+
+		// Throws BoardGeneratorError if the options contradict each other
+		static PostContainer Generate(const Options& options);
+		// Generates the board and saves it through BoardParser, so the path's extension picks the format
+		static void GenerateFile(const Options& options, const std::string& path);
+
+		// Names used by the command line tool, the parsers throw BoardGeneratorError for unknown names
+		static const char* Name(ContentSize content_size);
+		static const char* Name(Graph graph);
+		static const char* Name(Layout layout);
+		static ContentSize ContentSizeFromName(const std::string& name);
+		static Graph GraphFromName(const std::string& name);
+		static Layout LayoutFromName(const std::string& name);
+	};
+}
\ No newline at end of file
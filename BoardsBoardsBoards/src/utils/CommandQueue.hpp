@@ -1,41 +1,76 @@
 #pragma once
 
-#include <utility>
-#include <queue>
+#include <cstddef>
+#include <optional>
 #include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
+#include "containers/MPSCQueue.hpp"
 #include "utils/Error.hpp"
+#include "utils/FrameWake.hpp"
 
 namespace board
 {
+	// Typed commands routed to the layer that handles them.
+	// Any thread may push a command; each target is drained by the UI thread, a bounded number per frame.
 	class CommandQueue
-	{ 
+	{
 	public:
-		enum class commands
-		{
-			openFile, closeAllTabs, createErrorWindow, openBoardOptions
-		};
-		enum class targets 
+		enum class targets
 		{
 			applicationLayer, widgetManager, currentTab
 		};
 
-		using CommandPair = std::pair<CommandQueue::commands, std::string>;
-		using Queue = std::queue<CommandPair>;
+		struct OpenFiles { std::vector<std::string> paths; }; // Opened as tabs in this order
+		struct CloseAllTabs {};
+		struct ErrorWindow { std::string what; };
+		struct OpenBoardOptions {};
+		struct Undo {};
+		struct Redo {};
+
+		using Command = std::variant<OpenFiles, CloseAllTabs, ErrorWindow, OpenBoardOptions, Undo, Redo>;
+
+		static constexpr std::size_t max_drain = 64; // Commands handled per target every frame, the rest wait for the next one
 
 		// alias function
 		static void CreateErrorWindow(const std::string& error)
 		{
-			addToQueue(CommandQueue::targets::widgetManager, CommandQueue::commands::createErrorWindow, error);
+			Push(targets::widgetManager, ErrorWindow{ error });
+		}
+		static void Push(targets target, Command command)
+		{
+			get(target).Push(std::move(command));
+			utils::FrameWake::Request(); // The UI thread may be waiting for input
 		}
-		static void addToQueue(enum targets target, enum commands operation, const std::string& data = "")
+
+		// UI thread only. True while any target has commands left for the next frames
+		static bool Pending()
+		{
+			return !appLevelCommands.Empty() || !windowsLevelCommands.Empty() || !currentTabCommands.Empty();
+		}
+
+		// Calls handle on up to max commands of target in the order they were pushed, returns how many were handled.
+		// Only the UI thread may drain. A command is removed before it is handled, so a throwing handler does not see it again.
+		template<typename Handler>
+		static std::size_t Drain(targets target, Handler&& handle, std::size_t max = max_drain)
 		{
-			get(target).emplace(operation, data);
+			Queue& queue = get(target);
+			std::size_t handled = 0;
+			while (handled < max)
+			{
+				std::optional<Command> command = queue.TryPop();
+				if (!command) break;
+				handled++;
+				handle(*command);
+			}
+			return handled;
 		}
-		static CommandPair& front(enum targets target) {	return get(target).front();	}
-		static void pop(enum targets target) { get(target).pop(); }
-		static bool empty(enum targets target)	{ return get(target).empty(); }
+
 	private:
+		using Queue = MPSCQueue<Command>;
+
 		static inline Queue& get(enum targets target)
 		{
 			switch (target)
@@ -66,6 +66,12 @@ namespace utils
 		PostContainerError(std::string msg = "Post Container: unknown operation.") : Error(std::move(msg)) {}
 	};
 
+	class EditHistoryError : public Error
+	{
+	public:
+		EditHistoryError(std::string msg = "The edit history does not match the board.") : Error(std::move(msg)) {}
+	};
+
 	class BoardRenderError : public Error
 	{
 	public:
@@ -84,4 +90,22 @@ namespace utils
 		PostContentError(std::string msg = "Could not operate on PostContent instance") : Error(std::move(msg)) {}
 	};
 
+	class BoardLoadError : public Error
+	{
+	public:
+		BoardLoadError(std::string msg = "Could not load board.") : Error(std::move(msg)) {}
+	};
+
+	class LoadCancelledError : public BoardLoadError
+	{
+	public:
+		LoadCancelledError(std::string msg = "Board loading was cancelled.") : BoardLoadError(std::move(msg)) {}
+	};
+
+	class BoardGeneratorError : public Error
+	{
+	public:
+		BoardGeneratorError(std::string msg = "Invalid board generator options.") : Error(std::move(msg)) {}
+	};
+
 }
\ No newline at end of file
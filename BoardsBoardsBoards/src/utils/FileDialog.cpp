@@ -1,18 +1,24 @@
 #include "FileDialog.hpp"
 #include <nfd.h>
 
+#include "utils/parsing/BinaryBoardFormat.hpp"
+
 namespace board
 {
     using utils::FileOpenError;
     using utils::FileWriteError;
 
+    using utils::BinaryBoardFormat;
+
     const string extension = "lua";
     const string dot_extension = "." + extension;
+    const string open_filter = extension + "," + string(BinaryBoardFormat::extension); // One filter that shows both formats
+    const string save_filter = extension + ";" + string(BinaryBoardFormat::extension); // One filter per format
 
     string FileDialog::Open()
     {
         nfdchar_t* outPath = NULL;
-        nfdresult_t result = NFD_OpenDialog(extension.data(), NULL, &outPath);
+        nfdresult_t result = NFD_OpenDialog(open_filter.data(), NULL, &outPath);
 
         switch (result)
         {
@@ -28,7 +34,7 @@ namespace board
     vector<string> FileDialog::OpenMultiple()
     {
         nfdpathset_t outPaths;
-        nfdresult_t result = NFD_OpenDialogMultiple(extension.data(), NULL, &outPaths);
+        nfdresult_t result = NFD_OpenDialogMultiple(open_filter.data(), NULL, &outPaths);
         vector<string> paths;
 
         switch (result)
@@ -50,14 +56,14 @@ namespace board
     string FileDialog::Save()
     {
         nfdchar_t* outPath = NULL;
-        nfdresult_t result = NFD_SaveDialog(extension.data(), NULL, &outPath);
+        nfdresult_t result = NFD_SaveDialog(save_filter.data(), NULL, &outPath);
 
         switch (result)
         {
         case (NFD_OKAY):
         {
             string ret = outPath;
-            if (!ret.contains(dot_extension))
+            if (!ret.ends_with(dot_extension) && !BinaryBoardFormat::HasExtension(ret))
             {
                 ret += dot_extension;
             }
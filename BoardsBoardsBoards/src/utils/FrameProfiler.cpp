@@ -0,0 +1,117 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm> // std::copy_n, std::max, std::nth_element, std::min
+#include <cmath> // std::ceil
+#include <cstdio> // std::snprintf
+
+#include "imgui.h"
+#include "renderables/DearImGuiFlags.hpp"
+
+namespace utils
+{
+	void FrameProfiler::Timer::Stop()
+	{
+		if (stopped) return;
+		stopped = true;
+		Add(phase, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	void FrameProfiler::Add(Phase phase, double milliseconds)
+	{
+		current[std::size_t(phase)] += milliseconds;
+	}
+
+	void FrameProfiler::EndFrame()
+	{
+		for (std::size_t i = 0; i < phase_count; i++)
+		{
+			history[i][next] = float(current[i]);
+			current[i] = 0.0;
+		}
+		next = (next + 1) % history_size;
+		frames = std::min(frames + 1, history_size);
+	}
+
+	void FrameProfiler::Clear()
+	{
+		current.fill(0.0);
+		for (auto& phase_history : history) phase_history.fill(0.f);
+		next = 0;
+		frames = 0;
+	}
+
+	float FrameProfiler::Last(Phase phase)
+	{
+		if (frames == 0) return 0.f;
+		return history[std::size_t(phase)][(next + history_size - 1) % history_size];
+	}
+
+	float FrameProfiler::Percentile(Phase phase, double percentile)
+	{
+		if (frames == 0) return 0.f;
+
+		// Until the history is full the frames are in [0, frames), afterwards every slot holds one
+		static std::array<float, history_size> sorted;
+		std::copy_n(history[std::size_t(phase)].begin(), frames, sorted.begin());
+
+		const double rank = std::ceil(percentile / 100.0 * double(frames));
+		const std::size_t index = rank < 1.0 ? 0 : std::min(std::size_t(rank) - 1, frames - 1);
+		std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + frames);
+		return sorted[index];
+	}
+
+	const char* FrameProfiler::Name(Phase phase)
+	{
+		static constexpr std::array<const char*, phase_count> names =
+		{
+			"Frame", "WidgetManager::RenderAll", "CommandQueueLookup", "PopulateCurrentFrameInfo",
+			"Post layout", "RenderConnections", "ChannelsMerge", "Popups"
+		};
+		return names[std::size_t(phase)];
+	}
+
+	void FrameProfiler::ShowOverlay()
+	{
+		ImGui::Begin("Frame profiler", nullptr, board::PopupWindowFlags);
+
+		const float frame_p50 = Percentile(Phase::Frame, 50.0);
+		const float frame_p99 = Percentile(Phase::Frame, 99.0);
+		char overlay[64];
+		std::snprintf(overlay, sizeof(overlay), "p50 %.2f ms, p99 %.2f ms", frame_p50, frame_p99);
+
+		// Oldest frame on the left; the 60 FPS budget stays in view while frames are cheaper than it
+		const float scale_max = std::max(frame_p99 * 1.5f, 1000.f / 60.f);
+		ImGui::PlotLines("##frame time", history[std::size_t(Phase::Frame)].data(), int(history_size), int(next),
+			overlay, 0.f, scale_max, ImVec2(ImGui::GetFontSize() * 24.f, ImGui::GetFontSize() * 5.f));
+
+		if (ImGui::BeginTable("phases", 4, board::TableFlags))
+		{
+			ImGui::TableSetupColumn("Phase");
+			ImGui::TableSetupColumn("Last (ms)");
+			ImGui::TableSetupColumn("p50");
+			ImGui::TableSetupColumn("p99");
+			ImGui::TableHeadersRow();
+
+			for (std::size_t i = 0; i < phase_count; i++)
+			{
+				const Phase phase = Phase(i);
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				// Every phase after WidgetManager::RenderAll runs inside it
+				if (i > std::size_t(Phase::WidgetManagerRenderAll)) ImGui::Indent();
+				ImGui::TextUnformatted(Name(phase));
+				if (i > std::size_t(Phase::WidgetManagerRenderAll)) ImGui::Unindent();
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", Last(phase));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", Percentile(phase, 50.0));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", Percentile(phase, 99.0));
+			}
+			ImGui::EndTable();
+		}
+
+		ImGui::Text("Over the last %zu frames", frames);
+		ImGui::End();
+	}
+}
\ No newline at end of file
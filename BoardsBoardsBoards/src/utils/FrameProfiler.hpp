@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// The timers are compiled in Debug builds, and in Release builds when BOARD_PROFILE is defined (premake5 --profile).
+// Otherwise BOARD_PROFILE_SCOPE and BOARD_PROFILE_END expand to nothing.
+#if defined(BOARD_DEBUG) || defined(BOARD_PROFILE)
+#define BOARD_PROFILING
+#define BOARD_PROFILE_SCOPE(phase) utils::FrameProfiler::Timer profile_##phase(utils::FrameProfiler::Phase::phase)
+#define BOARD_PROFILE_END(phase) profile_##phase.Stop() // Ends the scope's timer early
+#else
+#define BOARD_PROFILE_SCOPE(phase) ((void)0)
+#define BOARD_PROFILE_END(phase) ((void)0)
+#endif
+
+namespace utils
+{
+	// Time spent by the UI thread in each phase of a frame, kept for the last history_size frames.
+	// Phases entered several times in a frame are summed. Only the UI thread may use it.
+	class FrameProfiler
+	{
+	public:
+		enum class Phase : std::size_t
+		{
+			Frame, // From NewFrame until the draw data is submitted
+			WidgetManagerRenderAll,
+			CommandQueueLookup,
+			PopulateCurrentFrameInfo,
+			PostLayout,
+			RenderConnections,
+			ChannelsMerge,
+			Popups,
+			Count
+		};
+		static constexpr std::size_t phase_count = std::size_t(Phase::Count);
+		static constexpr std::size_t history_size = 240; // Four seconds at 60 frames per second
+
+		class Timer
+		{
+		public:
+			Timer(Phase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+			~Timer() { Stop(); }
+			Timer(const Timer&) = delete;
+			Timer& operator=(const Timer&) = delete;
+
+			void Stop(); // Only the first call adds the time
+
+		private:
+			Phase phase;
+			std::chrono::steady_clock::time_point start;
+			bool stopped = false;
+		};
+
+		static void Add(Phase phase, double milliseconds);
+		static void EndFrame(); // Called by the UI thread after every frame, moves the current frame into the history
+		static void Clear();
+
+		static std::size_t Frames() { return frames; } // Frames in the history, up to history_size
+		static float Last(Phase phase); // Milliseconds spent in the last ended frame
+		static float Percentile(Phase phase, double percentile); // Nearest rank over the history, 50 is the median
+		static const char* Name(Phase phase);
+
+		static void ShowOverlay(); // Frame time graph and per-phase table, inside its own window
+
+	private:
+		static inline std::array<double, phase_count> current{};
+		static inline std::array<std::array<float, history_size>, phase_count> history{};
+		static inline std::size_t next = 0; // Slot of the next ended frame, the oldest one once the history is full
+		static inline std::size_t frames = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+
+namespace utils
+{
+	// Ends the UI thread's idle wait from any thread, after queueing a command or finishing a background job.
+	// The application installs the function that wakes its event loop; until then Request does nothing.
+	class FrameWake
+	{
+	public:
+		using WakeFunction = void(*)();
+
+		static void Install(WakeFunction function)
+		{
+			wake.store(function, std::memory_order_release);
+		}
+
+		static void Request()
+		{
+			if (WakeFunction function = wake.load(std::memory_order_acquire)) function();
+		}
+
+	private:
+		static inline std::atomic<WakeFunction> wake = nullptr;
+	};
+}
\ No newline at end of file
@@ -11,7 +11,7 @@ namespace utils
 {
 	sol::table LuaStack::EmptyTable() //TODO check if this creates the table on the stack and if it persists
 	{
-		return sol::table(lua_state, sol::create);
+		return sol::table(State(), sol::create);
 	}
 	string LuaStack::StringFromFile(const string& path)
 	{
@@ -97,31 +97,42 @@ namespace utils
 		return DeserializeTableString(serialized);
 	}
 
+	sol::state& LuaStack::State()
+	{
+		if (!lua_state)
+		{
+			auto state = std::make_unique<sol::state>();
+			Prepare(*state);
+			lua_state = std::move(state);
+		}
+		return *lua_state;
+	}
+
 	void LuaStack::Init()
 	{
-		LoadBaseLibs();
-		lua_state.require_file("serpent", "scripts/serpent/src/serpent.lua");
+		if (lua_state) Prepare(*lua_state);
+		else State();
 	}
 
 	void LuaStack::FlushStack()
 	{
-		lua_state = sol::state();
-		Init();
+		lua_state.reset();
+		State();
 	}
 
 	void LuaStack::ScriptToGlobal(const string& path)
 	{
-		lua_state.script_file(path); //TODO error catching
+		State().script_file(path); //TODO error catching
 	}
 
 	sol::object LuaStack::Require(const string& key, const string& path)
 	{
-		return lua_state.require_file(key, path);
+		return State().require_file(key, path);
 	}
 	
 	sol::object LuaStack::GetVariableFromStack(const string& object_name)
 	{
-		auto object = lua_state[object_name];
+		auto object = State()[object_name];
 		if (!object.valid())
 		{
 			throw LuaAccessError("Object '" + object_name + "' does not exist in the current stack");
@@ -129,15 +140,16 @@ namespace utils
 		return object.get<sol::object>();
 	}
 	
-	void LuaStack::LoadBaseLibs()
+	void LuaStack::Prepare(sol::state& state)
 	{
-		lua_state.open_libraries(sol::lib::base, sol::lib::package, sol::lib::math, sol::lib::table, sol::lib::string);
+		state.open_libraries(sol::lib::base, sol::lib::package, sol::lib::math, sol::lib::table, sol::lib::string);
+		state.require_file("serpent", "scripts/serpent/src/serpent.lua");
 	}
 
 	
 	sol::table LuaStack::GetGlobalTable(const string& table_name)
 	{
-		auto table = lua_state[table_name];
+		auto table = State()[table_name];
 		if (!table.valid())
 		{
 			throw LuaAccessError("Table '" + table_name + "' does not exist in the current stack");
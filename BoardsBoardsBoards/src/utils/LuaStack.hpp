@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "sol/sol.hpp"
@@ -8,14 +9,16 @@ namespace utils
 {
 	using std::string;
 
+	// Every thread gets its own Lua state, created the first time the thread uses LuaStack, with serpent already loaded.
+	// Tables and objects belong to the state of the thread that made them and must not be handed to another thread.
 	class LuaStack
 	{
 		
 	public:
 
 		//--- BASIC STACK OPERATIONS ---
-		static void        Init();
-		static void        FlushStack();
+		static void        Init(); // Reloads the libraries and serpent into the calling thread's state
+		static void        FlushStack(); // Replaces the calling thread's state with a fresh one
 		static void        ScriptToGlobal(const string& path);
 		static sol::object Require(const string& key, const string& path);
 		//--- BASIC STACK OPERATIONS ---
@@ -40,7 +43,8 @@ namespace utils
 		static sol::table  DeserializeTableString(const string& serialized_table);
 		//--- SERIALIZATION
 	private:
-		static inline sol::state lua_state;
-		static void LoadBaseLibs();
+		static inline thread_local std::unique_ptr<sol::state> lua_state;
+		static sol::state& State();
+		static void Prepare(sol::state& state);
 	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath> // std::trunc
 #include <variant>
 #include <string>
 #include <sstream>
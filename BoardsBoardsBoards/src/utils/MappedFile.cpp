@@ -0,0 +1,137 @@
+#include "MappedFile.hpp"
+
+#include <utility> // std exchange
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utils/Error.hpp"
+
+namespace utils
+{
+#ifdef WIN32
+	MappedFile::MappedFile(const std::string& path)
+	{
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw FileOpenError(path);
+		}
+		file_handle = file;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size))
+		{
+			Close();
+			throw FileOpenError("Could not read the size of " + path + ".");
+		}
+		view_size = static_cast<std::size_t>(file_size.QuadPart);
+		if (view_size == 0) return; // Empty files cannot be mapped, but they are still valid files
+
+		mapping_handle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping_handle == NULL)
+		{
+			Close();
+			throw FileOpenError("Could not map " + path + " into memory.");
+		}
+		view = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		if (view == nullptr)
+		{
+			Close();
+			throw FileOpenError("Could not map " + path + " into memory.");
+		}
+	}
+
+	void MappedFile::Close()
+	{
+		if (view != nullptr) UnmapViewOfFile(view);
+		if (mapping_handle != nullptr) CloseHandle(mapping_handle);
+		if (file_handle != nullptr) CloseHandle(file_handle);
+		view = nullptr;
+		view_size = 0;
+		mapping_handle = nullptr;
+		file_handle = nullptr;
+	}
+
+	MappedFile::MappedFile(MappedFile&& rhs) noexcept
+		: view(std::exchange(rhs.view, nullptr)), view_size(std::exchange(rhs.view_size, 0)),
+		file_handle(std::exchange(rhs.file_handle, nullptr)), mapping_handle(std::exchange(rhs.mapping_handle, nullptr)) {}
+
+	MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			Close();
+			view = std::exchange(rhs.view, nullptr);
+			view_size = std::exchange(rhs.view_size, 0);
+			file_handle = std::exchange(rhs.file_handle, nullptr);
+			mapping_handle = std::exchange(rhs.mapping_handle, nullptr);
+		}
+		return *this;
+	}
+#else
+	MappedFile::MappedFile(const std::string& path)
+	{
+		file_descriptor = open(path.c_str(), O_RDONLY);
+		if (file_descriptor < 0)
+		{
+			throw FileOpenError(path);
+		}
+
+		struct stat file_stats;
+		if (fstat(file_descriptor, &file_stats) != 0)
+		{
+			Close();
+			throw FileOpenError("Could not read the size of " + path + ".");
+		}
+		view_size = static_cast<std::size_t>(file_stats.st_size);
+		if (view_size == 0) return; // Empty files cannot be mapped, but they are still valid files
+
+		void* mapped = mmap(nullptr, view_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+		if (mapped == MAP_FAILED)
+		{
+			Close();
+			throw FileOpenError("Could not map " + path + " into memory.");
+		}
+		view = static_cast<const unsigned char*>(mapped);
+	}
+
+	void MappedFile::Close()
+	{
+		if (view != nullptr) munmap(const_cast<unsigned char*>(view), view_size);
+		if (file_descriptor >= 0) close(file_descriptor);
+		view = nullptr;
+		view_size = 0;
+		file_descriptor = -1;
+	}
+
+	MappedFile::MappedFile(MappedFile&& rhs) noexcept
+		: view(std::exchange(rhs.view, nullptr)), view_size(std::exchange(rhs.view_size, 0)),
+		file_descriptor(std::exchange(rhs.file_descriptor, -1)) {}
+
+	MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			Close();
+			view = std::exchange(rhs.view, nullptr);
+			view_size = std::exchange(rhs.view_size, 0);
+			file_descriptor = std::exchange(rhs.file_descriptor, -1);
+		}
+		return *this;
+	}
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+}
\ No newline at end of file
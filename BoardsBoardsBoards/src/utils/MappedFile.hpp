@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace utils
+{
+	// Read-only view of a whole file mapped into memory.
+	// The view stays valid for as long as the MappedFile is alive.
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& path); // Throws FileOpenError if the file cannot be opened or mapped
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& rhs) noexcept;
+		MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+		const unsigned char* data() const { return view; }
+		std::size_t size() const { return view_size; }
+		bool Empty() const { return view_size == 0; }
+
+	private:
+		const unsigned char* view = nullptr;
+		std::size_t view_size = 0;
+#ifdef WIN32
+		void* file_handle = nullptr;
+		void* mapping_handle = nullptr;
+#else
+		int file_descriptor = -1;
+#endif
+
+		void Close();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm> // std::max
+
+namespace utils
+{
+	WorkerPool::WorkerPool(std::size_t thread_count)
+	{
+		threads.reserve(thread_count);
+		for (std::size_t i = 0; i < std::max<std::size_t>(thread_count, 1); i++)
+		{
+			threads.emplace_back([this](std::stop_token stop) { Work(stop); });
+		}
+	}
+
+	void WorkerPool::Submit(std::function<void()> job)
+	{
+		{
+			std::lock_guard lock(mutex);
+			jobs.push_back(std::move(job));
+		}
+		wake.notify_one();
+	}
+
+	std::size_t WorkerPool::DefaultThreadCount()
+	{
+		const std::size_t hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 1;
+	}
+
+	WorkerPool& WorkerPool::Shared()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	void WorkerPool::Work(std::stop_token stop)
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock lock(mutex);
+				if (!wake.wait(lock, stop, [this]() { return !jobs.empty(); })) return;
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+	// Fixed set of threads running submitted jobs in the order they were submitted.
+	// Jobs must catch their own exceptions. Jobs still queued when the pool is destroyed are dropped.
+	class WorkerPool
+	{
+	public:
+		WorkerPool(std::size_t thread_count = DefaultThreadCount());
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		void Submit(std::function<void()> job);
+		std::size_t ThreadCount() const { return threads.size(); }
+
+		static std::size_t DefaultThreadCount(); // One per hardware thread, minus the UI thread
+		static WorkerPool& Shared(); // Created on first use and shared by every board loader
+
+	private:
+		void Work(std::stop_token stop);
+
+		std::mutex mutex;
+		std::condition_variable_any wake;
+		std::deque<std::function<void()>> jobs;
+		std::vector<std::jthread> threads; // Declared last, so the threads are stopped and joined before the queue is destroyed
+	};
+}
\ No newline at end of file
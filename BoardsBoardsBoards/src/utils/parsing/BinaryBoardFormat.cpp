@@ -0,0 +1,457 @@
+#include <algorithm> // std::equal
+#include <bit> // std::bit_cast
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+#include "BinaryBoardFormat.hpp"
+#include "utils/MappedFile.hpp"
+
+namespace utils
+{
+	using board::Post;
+	using board::PostID;
+	using board::PostContent;
+
+	static constexpr unsigned char magic[8] = { 'B', 'B', 'B', 'B', 'O', 'A', 'R', 'D' };
+
+	static constexpr std::uint32_t header_fields = 8; // version and the seven counts
+	static constexpr std::uint32_t color_fields = 15;
+	static constexpr std::uint32_t string_fields = 2;
+	static constexpr std::uint32_t post_fields = 9;
+	static constexpr std::uint32_t content_fields = 3;
+	static constexpr std::uint32_t tag_fields = 3;
+	static constexpr std::uint32_t value_fields = 2;
+	static constexpr std::uint32_t connection_fields = 2;
+
+	static constexpr std::uint32_t content_text = 0;
+	static constexpr std::uint32_t content_image = 1;
+	static constexpr std::uint32_t no_string = UINT32_MAX;
+
+	// Tag value types follow LuaValue's variant indices
+	static constexpr std::uint32_t value_int = 0;
+	static constexpr std::uint32_t value_float = 1;
+	static constexpr std::uint32_t value_bool = 2;
+	static constexpr std::uint32_t value_string = 3;
+
+	struct Counts
+	{
+		std::uint32_t posts = 0;
+		std::uint32_t contents = 0;
+		std::uint32_t tags = 0;
+		std::uint32_t values = 0;
+		std::uint32_t connections = 0;
+		std::uint32_t strings = 0;
+		std::uint32_t string_bytes = 0;
+
+		std::uint64_t FileSize() const
+		{
+			std::uint64_t fields = header_fields + color_fields;
+			fields += std::uint64_t(strings) * string_fields;
+			fields += std::uint64_t(posts) * post_fields;
+			fields += std::uint64_t(contents) * content_fields;
+			fields += std::uint64_t(tags) * tag_fields;
+			fields += std::uint64_t(values) * value_fields;
+			fields += std::uint64_t(connections) * connection_fields;
+			return sizeof(magic) + fields * sizeof(std::uint32_t) + string_bytes;
+		}
+	};
+
+	class BinaryWriter
+	{
+	public:
+		BinaryWriter(std::vector<unsigned char>& out) : out(out) {}
+
+		void Write(std::uint32_t value)
+		{
+			out.push_back(static_cast<unsigned char>(value));
+			out.push_back(static_cast<unsigned char>(value >> 8));
+			out.push_back(static_cast<unsigned char>(value >> 16));
+			out.push_back(static_cast<unsigned char>(value >> 24));
+		}
+		void Write(float value) { Write(std::bit_cast<std::uint32_t>(value)); }
+		void Write(const float (&color)[3])
+		{
+			Write(color[0]);
+			Write(color[1]);
+			Write(color[2]);
+		}
+		void WriteBytes(const void* data, std::size_t size)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			out.insert(out.end(), bytes, bytes + size);
+		}
+
+	private:
+		std::vector<unsigned char>& out;
+	};
+
+	// Reads a section of fixed-size records; the caller has already checked that the data is long enough
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const unsigned char* data) : data(data) {}
+
+		std::uint32_t ReadU32()
+		{
+			const std::uint32_t value = std::uint32_t(data[0]) | (std::uint32_t(data[1]) << 8) | (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 24);
+			data += sizeof(std::uint32_t);
+			return value;
+		}
+		float ReadFloat() { return std::bit_cast<float>(ReadU32()); }
+		void ReadColor(float (&color)[3])
+		{
+			color[0] = ReadFloat();
+			color[1] = ReadFloat();
+			color[2] = ReadFloat();
+		}
+		const unsigned char* Position() const { return data; }
+
+	private:
+		const unsigned char* data;
+	};
+
+	// Gives every distinct string one entry in the string table
+	class StringTable
+	{
+	public:
+		std::uint32_t Add(std::string_view str)
+		{
+			auto [it, inserted] = indices.try_emplace(str, std::uint32_t(entries.size()));
+			if (inserted)
+			{
+				if (bytes.size() + str.size() > UINT32_MAX) throw SerializingError("The board is too large to be saved in the binary format.");
+				entries.push_back({ std::uint32_t(bytes.size()), std::uint32_t(str.size()) });
+				bytes.insert(bytes.end(), str.begin(), str.end());
+			}
+			return it->second;
+		}
+
+		struct Entry
+		{
+			std::uint32_t offset;
+			std::uint32_t length;
+		};
+		std::vector<Entry> entries;
+		std::vector<char> bytes;
+
+	private:
+		std::unordered_map<std::string_view, std::uint32_t> indices; // Views into the container being serialized
+	};
+
+	bool BinaryBoardFormat::IsBinaryBoard(const unsigned char* data, std::size_t size)
+	{
+		return size >= sizeof(magic) && std::equal(std::begin(magic), std::end(magic), data);
+	}
+
+	bool BinaryBoardFormat::HasExtension(const std::string& path)
+	{
+		return path.size() > extension.size() && path.ends_with(extension) && path[path.size() - extension.size() - 1] == '.';
+	}
+
+	std::vector<unsigned char> BinaryBoardFormat::Serialize(const PostContainer& container)
+	{
+		// Posts are written bottom to top so the stacking order survives a reload
+		const std::vector<PostID> draw_order = container.GetDrawOrder();
+		std::unordered_map<PostID, std::uint32_t> file_positions;
+		file_positions.reserve(draw_order.size());
+
+		StringTable strings;
+		std::vector<std::uint32_t> posts;
+		std::vector<std::uint32_t> contents;
+		std::vector<std::uint32_t> tags;
+		std::vector<std::uint32_t> values;
+		posts.reserve(draw_order.size() * post_fields);
+
+		for (const PostID id : draw_order)
+		{
+			const Post& post = container[id];
+			file_positions[id] = std::uint32_t(file_positions.size());
+
+			posts.push_back(std::bit_cast<std::uint32_t>(post.display_pos.first));
+			posts.push_back(std::bit_cast<std::uint32_t>(post.display_pos.second));
+			posts.push_back(std::bit_cast<std::uint32_t>(post.color[0]));
+			posts.push_back(std::bit_cast<std::uint32_t>(post.color[1]));
+			posts.push_back(std::bit_cast<std::uint32_t>(post.color[2]));
+			posts.push_back(std::uint32_t(contents.size() / content_fields));
+			posts.push_back(std::uint32_t(post.content.size()));
+			posts.push_back(std::uint32_t(tags.size() / tag_fields));
+
+			std::uint32_t tag_count = 0;
+			for (const PostContent& content : post.content)
+			{
+				if (content.IsString())
+				{
+					contents.push_back(content_text);
+					contents.push_back(strings.Add(content.AsString()));
+					contents.push_back(no_string);
+				}
+				else
+				{
+					const board::ImageInfo& image = content.AsImageInfo();
+					contents.push_back(content_image);
+					contents.push_back(strings.Add(image.first));
+					contents.push_back(strings.Add(image.second));
+				}
+			}
+
+			for (const auto& [key, entries] : post.tags)
+			{
+				tags.push_back(strings.Add(key));
+				tags.push_back(std::uint32_t(values.size() / value_fields));
+				tags.push_back(std::uint32_t(entries.size()));
+				tag_count++;
+
+				for (const LuaValue& entry : entries)
+				{
+					values.push_back(std::uint32_t(entry.index()));
+					switch (entry.index())
+					{
+					case value_int:
+						values.push_back(std::bit_cast<std::uint32_t>(entry.asInt()));
+						break;
+					case value_float:
+						values.push_back(std::bit_cast<std::uint32_t>(entry.asFloat()));
+						break;
+					case value_bool:
+						values.push_back(entry.asBool() ? 1 : 0);
+						break;
+					case value_string:
+						values.push_back(strings.Add(entry.asString()));
+						break;
+					default:
+						throw SerializingError("Cannot serialize unknown Tag type");
+					}
+				}
+			}
+			posts.push_back(tag_count);
+		}
+
+		Counts counts;
+		counts.posts = std::uint32_t(draw_order.size());
+		counts.contents = std::uint32_t(contents.size() / content_fields);
+		counts.tags = std::uint32_t(tags.size() / tag_fields);
+		counts.values = std::uint32_t(values.size() / value_fields);
+		counts.connections = std::uint32_t(container.GetConnections().size());
+		counts.strings = std::uint32_t(strings.entries.size());
+		counts.string_bytes = std::uint32_t(strings.bytes.size());
+
+		std::vector<unsigned char> result;
+		result.reserve(static_cast<std::size_t>(counts.FileSize()));
+		BinaryWriter writer(result);
+
+		writer.WriteBytes(magic, sizeof(magic));
+		writer.Write(version);
+		writer.Write(counts.posts);
+		writer.Write(counts.contents);
+		writer.Write(counts.tags);
+		writer.Write(counts.values);
+		writer.Write(counts.connections);
+		writer.Write(counts.strings);
+		writer.Write(counts.string_bytes);
+
+		const auto& color_table = container.board_options.color_table;
+		writer.Write(color_table.text);
+		writer.Write(color_table.post);
+		writer.Write(color_table.bg);
+		writer.Write(color_table.connection);
+		writer.Write(color_table.selected_connection);
+
+		for (const StringTable::Entry& entry : strings.entries)
+		{
+			writer.Write(entry.offset);
+			writer.Write(entry.length);
+		}
+		for (const std::uint32_t field : posts) writer.Write(field);
+		for (const std::uint32_t field : contents) writer.Write(field);
+		for (const std::uint32_t field : tags) writer.Write(field);
+		for (const std::uint32_t field : values) writer.Write(field);
+		for (const PostContainer::PostConnection& connection : container.GetConnections())
+		{
+			writer.Write(file_positions.at(connection.from));
+			writer.Write(file_positions.at(connection.to));
+		}
+		writer.WriteBytes(strings.bytes.data(), strings.bytes.size());
+
+		return result;
+	}
+
+	void BinaryBoardFormat::ToFile(const PostContainer& container, const std::string& path)
+	{
+		const std::vector<unsigned char> serialized = Serialize(container);
+		std::ofstream file(path, std::fstream::out | std::fstream::binary);
+		if (!file) throw FileWriteError("Could not open " + path + " for writing.");
+		file.write(reinterpret_cast<const char*>(serialized.data()), serialized.size());
+		if (!file) throw FileWriteError("Could not write to " + path + ".");
+	}
+
+	PostContainer BinaryBoardFormat::Parse(const unsigned char* data, std::size_t size, LoadProgress* progress)
+	{
+		if (!IsBinaryBoard(data, size))
+		{
+			throw ParsingError("Not a binary board file.");
+		}
+		if (size < sizeof(magic) + (header_fields + color_fields) * sizeof(std::uint32_t))
+		{
+			throw ParsingError("Binary board file is truncated.");
+		}
+
+		BinaryReader reader(data + sizeof(magic));
+		const std::uint32_t file_version = reader.ReadU32();
+		if (file_version != version)
+		{
+			throw ParsingError("Binary board version " + std::to_string(file_version) + " is not supported.");
+		}
+
+		Counts counts;
+		counts.posts = reader.ReadU32();
+		counts.contents = reader.ReadU32();
+		counts.tags = reader.ReadU32();
+		counts.values = reader.ReadU32();
+		counts.connections = reader.ReadU32();
+		counts.strings = reader.ReadU32();
+		counts.string_bytes = reader.ReadU32();
+		if (counts.FileSize() != size)
+		{
+			throw ParsingError("Binary board file is truncated or corrupted.");
+		}
+
+		PostContainer container;
+		auto& color_table = container.board_options.color_table;
+		reader.ReadColor(color_table.text);
+		reader.ReadColor(color_table.post);
+		reader.ReadColor(color_table.bg);
+		reader.ReadColor(color_table.connection);
+		reader.ReadColor(color_table.selected_connection);
+
+		const unsigned char* string_entries = reader.Position();
+		const unsigned char* post_records = string_entries + std::size_t(counts.strings) * string_fields * sizeof(std::uint32_t);
+		const unsigned char* content_records = post_records + std::size_t(counts.posts) * post_fields * sizeof(std::uint32_t);
+		const unsigned char* tag_records = content_records + std::size_t(counts.contents) * content_fields * sizeof(std::uint32_t);
+		const unsigned char* value_records = tag_records + std::size_t(counts.tags) * tag_fields * sizeof(std::uint32_t);
+		const unsigned char* connection_records = value_records + std::size_t(counts.values) * value_fields * sizeof(std::uint32_t);
+		const char* string_bytes = reinterpret_cast<const char*>(connection_records + std::size_t(counts.connections) * connection_fields * sizeof(std::uint32_t));
+
+		const auto string_at = [&](std::uint32_t idx) -> std::string
+		{
+			if (idx >= counts.strings) throw ParsingError("Binary board refers to a string that does not exist.");
+			BinaryReader entry(string_entries + std::size_t(idx) * string_fields * sizeof(std::uint32_t));
+			const std::uint32_t offset = entry.ReadU32();
+			const std::uint32_t length = entry.ReadU32();
+			if (std::uint64_t(offset) + length > counts.string_bytes) throw ParsingError("Binary board string is out of bounds.");
+			return std::string(string_bytes + offset, length);
+		};
+
+		const auto check_range = [](std::uint32_t first, std::uint32_t count, std::uint32_t total, const char* section)
+		{
+			if (std::uint64_t(first) + count > total)
+			{
+				throw ParsingError(std::string("Binary board refers to ") + section + " that do not exist.");
+			}
+		};
+
+		// Posts and connections are applied together once the whole file was read
+		PostContainer::Batch batch(container);
+		std::vector<PostID> ids;
+		ids.reserve(counts.posts);
+
+		BinaryReader posts(post_records);
+		for (std::uint32_t i = 0; i < counts.posts; i++)
+		{
+			Post post;
+			post.display_pos.first = posts.ReadFloat();
+			post.display_pos.second = posts.ReadFloat();
+			posts.ReadColor(post.color);
+			const std::uint32_t first_content = posts.ReadU32();
+			const std::uint32_t content_count = posts.ReadU32();
+			const std::uint32_t first_tag = posts.ReadU32();
+			const std::uint32_t tag_count = posts.ReadU32();
+			check_range(first_content, content_count, counts.contents, "contents");
+			check_range(first_tag, tag_count, counts.tags, "tags");
+
+			post.content.Clear();
+			post.content.Reserve(content_count);
+			BinaryReader contents(content_records + std::size_t(first_content) * content_fields * sizeof(std::uint32_t));
+			for (std::uint32_t c = 0; c < content_count; c++)
+			{
+				const std::uint32_t type = contents.ReadU32();
+				const std::uint32_t first_string = contents.ReadU32();
+				const std::uint32_t second_string = contents.ReadU32();
+				switch (type)
+				{
+				case content_text:
+					post.content.EmplaceBack(string_at(first_string));
+					break;
+				case content_image:
+					post.content.EmplaceBack(string_at(first_string), string_at(second_string));
+					break;
+				default:
+					throw ParsingError("Binary board has content of an unknown type.");
+				}
+			}
+
+			BinaryReader tags(tag_records + std::size_t(first_tag) * tag_fields * sizeof(std::uint32_t));
+			for (std::uint32_t t = 0; t < tag_count; t++)
+			{
+				const std::string key = string_at(tags.ReadU32());
+				const std::uint32_t first_value = tags.ReadU32();
+				const std::uint32_t value_count = tags.ReadU32();
+				check_range(first_value, value_count, counts.values, "tag values");
+
+				auto& entries = post.tags[key];
+				BinaryReader values(value_records + std::size_t(first_value) * value_fields * sizeof(std::uint32_t));
+				for (std::uint32_t v = 0; v < value_count; v++)
+				{
+					const std::uint32_t type = values.ReadU32();
+					const std::uint32_t payload = values.ReadU32();
+					switch (type)
+					{
+					case value_int:
+						entries.EmplaceBack(std::bit_cast<int>(payload));
+						break;
+					case value_float:
+						entries.EmplaceBack(std::bit_cast<float>(payload));
+						break;
+					case value_bool:
+						entries.EmplaceBack(payload != 0);
+						break;
+					case value_string:
+						// Goes through the variant so strings such as "true" are not turned into bools
+						entries.EmplaceBack(LuaValue::Variant(string_at(payload)));
+						break;
+					default:
+						throw ParsingError("Cannot parse '" + key + "' key: unknown Tag type.");
+					}
+				}
+			}
+
+			ids.push_back(batch.InsertBack(std::move(post)));
+			if (progress && ids.size() % LoadProgress::report_interval == 0)
+			{
+				progress->ThrowIfCancelled();
+				progress->Report(float(ids.size()) / float(counts.posts));
+			}
+		}
+
+		BinaryReader connections(connection_records);
+		for (std::uint32_t i = 0; i < counts.connections; i++)
+		{
+			const std::uint32_t from = connections.ReadU32();
+			const std::uint32_t to = connections.ReadU32();
+			if (from >= ids.size() || to >= ids.size())
+			{
+				throw ParsingError("Connection refers to a Post that does not exist.");
+			}
+			batch.Connect(ids[from], ids[to]);
+		}
+
+		batch.Commit();
+		return container;
+	}
+
+	PostContainer BinaryBoardFormat::ParsePath(const std::string& path, LoadProgress* progress)
+	{
+		MappedFile file(path);
+		return Parse(file.data(), file.size(), progress);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "containers/PostContainer.hpp"
+#include "utils/Error.hpp"
+#include "LoadProgress.hpp"
+
+namespace utils
+{
+	using board::PostContainer;
+
+	// Versioned little-endian board format that is read straight from a memory-mapped file, without going through Lua.
+	// Layout, every field being a 32 bit unsigned integer or float unless noted otherwise:
+	//   header      magic (8 bytes), version, and the count of posts, contents, tags, tag values, connections, strings and string bytes
+	//   colors      the 15 floats of the board's color table: text, post, bg, connection, selected_connection
+	//   strings     { offset, length } into the string bytes; content and tag keys are stored once and shared
+	//   posts       { x, y, r, g, b, first content, content count, first tag, tag count } in draw order, bottom first
+	//   contents    { type, string, second string } where images keep their path and comment
+	//   tags        { key string, first value, value count }
+	//   tag values  { type, payload } where the payload is the raw int, float, bool or a string index
+	//   connections { from, to } as positions into the posts section, starting at 0
+	//   string bytes
+	class BinaryBoardFormat
+	{
+	public:
+		static constexpr std::uint32_t version = 1;
+		static constexpr std::string_view extension = "board";
+
+		static bool IsBinaryBoard(const unsigned char* data, std::size_t size); // Only checks the magic bytes
+		static bool HasExtension(const std::string& path);
+
+		// Throw ParsingError if the data is not a valid board of a supported version.
+		// With a LoadProgress, also throw LoadCancelledError once its stop is requested.
+		static PostContainer Parse(const unsigned char* data, std::size_t size, LoadProgress* progress = nullptr);
+		static PostContainer ParsePath(const std::string& path, LoadProgress* progress = nullptr);
+
+		static std::vector<unsigned char> Serialize(const PostContainer& container);
+		static void ToFile(const PostContainer& container, const std::string& path);
+	};
+}
\ No newline at end of file
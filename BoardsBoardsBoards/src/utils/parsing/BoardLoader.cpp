@@ -0,0 +1,44 @@
+#include "BoardLoader.hpp"
+#include "BoardParser.hpp"
+#include "utils/FrameWake.hpp"
+
+namespace utils
+{
+	BoardLoader::BoardLoader(std::string path, WorkerPool& pool) : state(std::make_shared<State>(std::move(path)))
+	{
+		pool.Submit([state = state]() { Load(*state); });
+	}
+
+	BoardLoader::~BoardLoader()
+	{
+		Cancel();
+	}
+
+	// Runs on a WorkerPool thread
+	void BoardLoader::Load(State& state)
+	{
+		try
+		{
+			state.progress.ThrowIfCancelled(); // Closed while it was still queued
+			state.result.emplace(BoardParser().LoadPath(state.path, &state.progress));
+			state.progress.Report(1.f);
+		}
+		catch (...)
+		{
+			state.error = std::current_exception();
+		}
+		state.done.store(true, std::memory_order_release);
+		FrameWake::Request(); // The tab takes the result on the next frame
+	}
+
+	PostContainer BoardLoader::Take()
+	{
+		if (!Done()) throw BoardLoadError("The board has not finished loading.");
+		if (state->error) std::rethrow_exception(state->error);
+		if (!state->result) throw BoardLoadError("The board was already taken from its loader.");
+
+		PostContainer container = std::move(*state->result);
+		state->result.reset();
+		return container;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <string>
+
+#include "containers/PostContainer.hpp"
+#include "utils/WorkerPool.hpp"
+#include "LoadProgress.hpp"
+
+namespace utils
+{
+	using board::PostContainer;
+
+	// Parses a board file on a WorkerPool thread through BoardParser::LoadPath.
+	// The owner polls Done() every frame and takes the result on its own thread once it is ready.
+	// Destroying the loader cancels the parse; a job that already started stops at its next progress report.
+	class BoardLoader
+	{
+	public:
+		BoardLoader(std::string path, WorkerPool& pool = WorkerPool::Shared());
+		~BoardLoader();
+		BoardLoader(const BoardLoader&) = delete;
+		BoardLoader& operator=(const BoardLoader&) = delete;
+
+		const std::string& Path() const { return state->path; }
+		bool Done() const { return state->done.load(std::memory_order_acquire); }
+		float Progress() const { return state->progress.Fraction(); }
+		void Cancel() { state->stop.request_stop(); }
+
+		// Throws BoardLoadError if !Done(), or rethrows the error that stopped the parse
+		PostContainer Take();
+
+	private:
+		struct State
+		{
+			State(std::string path) : path(std::move(path)), progress(stop.get_token()) {}
+
+			const std::string path;
+			std::stop_source stop;
+			LoadProgress progress;
+			std::optional<PostContainer> result;
+			std::exception_ptr error;
+			std::atomic<bool> done = false;
+		};
+
+		static void Load(State& state);
+
+		std::shared_ptr<State> state; // Shared with the job, which may still be queued or running once the loader is gone
+	};
+}
\ No newline at end of file
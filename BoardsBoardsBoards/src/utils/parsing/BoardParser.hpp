@@ -3,6 +3,10 @@
 #include "containers/PostContainer.hpp"
 #include "ScriptParser.hpp"
 #include "ParsingStrategies.hpp"
+#include "BinaryBoardFormat.hpp"
+#include "LuaBoardReader.hpp"
+#include "LuaBoardWriter.hpp"
+#include "utils/MappedFile.hpp"
 
 namespace utils
 {
@@ -13,5 +17,29 @@ namespace utils
 	{
 	public:
 		BoardParser(LuaTableIntoContainer parseTable = ParsingStrategies::TableToContainer, ContainerIntoLuaTable parseContainer = ParsingStrategies::ContainerToTable) : ScriptParser<PostContainer>(parseTable, parseContainer) {}
+
+		// Binary boards are recognized by their magic bytes, anything else is read as a Lua script by LuaBoardReader.
+		// Unlike ScriptParser::ParsePath, it does not go through the Lua state, so the strategies given to the constructor are not used
+		// and it is safe on any thread. Throws LoadCancelledError once the stop of progress is requested.
+		PostContainer LoadPath(const std::string& path, LoadProgress* progress = nullptr)
+		{
+			MappedFile file(path);
+			if (BinaryBoardFormat::IsBinaryBoard(file.data(), file.size()))
+			{
+				return BinaryBoardFormat::Parse(file.data(), file.size(), progress);
+			}
+			return LuaBoardReader::Parse(std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), progress);
+		}
+
+		// Paths ending in BinaryBoardFormat::extension are saved in the binary format, anything else as a Lua script by LuaBoardWriter.
+		void SavePath(const PostContainer& container, const std::string& path)
+		{
+			if (BinaryBoardFormat::HasExtension(path))
+			{
+				BinaryBoardFormat::ToFile(container, path);
+				return;
+			}
+			LuaBoardWriter::ToFile(container, path);
+		}
 	};
 }
\ No newline at end of file
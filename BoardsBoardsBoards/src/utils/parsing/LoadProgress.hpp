@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stop_token>
+
+#include "utils/Error.hpp"
+
+namespace utils
+{
+	// Shared between a parser running on a worker thread and the thread waiting for its result.
+	// The parser reports how far through the file it is and stops once the stop token is triggered.
+	class LoadProgress
+	{
+	public:
+		static constexpr std::size_t report_interval = 256; // Parsers report once every this many Posts
+
+		LoadProgress() = default;
+		LoadProgress(std::stop_token stop) : stop(std::move(stop)) {}
+
+		void Report(float fraction) { done.store(fraction, std::memory_order_relaxed); }
+		float Fraction() const { return done.load(std::memory_order_relaxed); } // Between 0 and 1
+
+		bool Cancelled() const { return stop.stop_requested(); }
+		// Throws LoadCancelledError if the stop was requested
+		void ThrowIfCancelled() const
+		{
+			if (Cancelled()) throw LoadCancelledError();
+		}
+
+	private:
+		std::atomic<float> done = 0.f;
+		std::stop_token stop;
+	};
+}
\ No newline at end of file
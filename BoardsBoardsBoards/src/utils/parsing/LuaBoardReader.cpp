@@ -0,0 +1,972 @@
+#include <charconv> // std::from_chars
+#include <cmath> // std::trunc
+#include <cstdint>
+#include <cstdlib> // std::strtod
+#include <vector>
+
+#include "LuaBoardReader.hpp"
+#include "utils/BoardColors.hpp"
+#include "utils/MappedFile.hpp"
+
+namespace utils
+{
+	using board::Post;
+	using board::PostID;
+	using board::Tags;
+
+	enum class LuaToken
+	{
+		left_brace, right_brace, left_bracket, right_bracket, equals, separator, minus, name, string, number, end
+	};
+
+	// Splits the source into tokens on demand; only one token is looked ahead
+	class LuaTableLexer
+	{
+	public:
+		struct Token
+		{
+			LuaToken type = LuaToken::end;
+			std::string_view text; // Points into the source, except for strings with escape sequences which live in 'scratch'
+			std::size_t line = 1;
+			std::size_t column = 1;
+		};
+
+		LuaTableLexer(std::string_view source) : source(source) {}
+
+		// The returned token stays valid until Skip is called
+		const Token& Peek()
+		{
+			if (!has_current)
+			{
+				Lex();
+				has_current = true;
+			}
+			return current;
+		}
+		void Skip()
+		{
+			Peek();
+			has_current = false;
+		}
+
+		float Fraction() const { return source.empty() ? 1.f : float(pos) / float(source.size()); }
+
+		[[noreturn]] void Fail(std::size_t line, std::size_t column, const std::string& msg) const
+		{
+			throw ParsingError("Line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + msg);
+		}
+		[[noreturn]] void Fail(const Token& at, const std::string& msg) const
+		{
+			Fail(at.line, at.column, msg);
+		}
+
+	private:
+		static constexpr std::size_t no_level = SIZE_MAX;
+
+		std::string_view source;
+		std::size_t pos = 0;
+		std::size_t line = 1;
+		std::size_t line_start = 0;
+		Token current;
+		bool has_current = false;
+		std::string scratch;
+
+		bool AtEnd() const { return pos >= source.size(); }
+		std::size_t Column() const { return pos - line_start + 1; }
+		static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+		static bool IsNameStart(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+		static bool IsNameChar(char c) { return IsNameStart(c) || IsDigit(c); }
+		static int HexValue(char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		// Treats "\n", "\r", "\n\r" and "\r\n" as a single line break, like Lua does
+		void SkipNewLine()
+		{
+			const char first = source[pos++];
+			if (!AtEnd() && (source[pos] == '\n' || source[pos] == '\r') && source[pos] != first) pos++;
+			line++;
+			line_start = pos;
+		}
+
+		// Returns the number of '=' in a long bracket starting at pos, or no_level if there is none
+		std::size_t LongBracketLevel() const
+		{
+			std::size_t level = 0;
+			while (pos + 1 + level < source.size() && source[pos + 1 + level] == '=') level++;
+			if (pos + 1 + level < source.size() && source[pos + 1 + level] == '[') return level;
+			return no_level;
+		}
+
+		void SkipWhitespaceAndComments()
+		{
+			while (!AtEnd())
+			{
+				const char c = source[pos];
+				if (c == '\n' || c == '\r')
+				{
+					SkipNewLine();
+				}
+				else if (c == ' ' || c == '\t' || c == '\v' || c == '\f')
+				{
+					pos++;
+				}
+				else if (c == '-' && pos + 1 < source.size() && source[pos + 1] == '-')
+				{
+					pos += 2;
+					const std::size_t level = (!AtEnd() && source[pos] == '[') ? LongBracketLevel() : no_level;
+					if (level != no_level)
+					{
+						LexLongString(level, "Unfinished long comment.");
+					}
+					else
+					{
+						while (!AtEnd() && source[pos] != '\n' && source[pos] != '\r') pos++;
+					}
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		void Lex()
+		{
+			SkipWhitespaceAndComments();
+			current.line = line;
+			current.column = Column();
+			const std::size_t start = pos;
+
+			if (AtEnd())
+			{
+				current.type = LuaToken::end;
+				current.text = {};
+				return;
+			}
+
+			const char c = source[pos];
+			switch (c)
+			{
+			case '{': current.type = LuaToken::left_brace; pos++; break;
+			case '}': current.type = LuaToken::right_brace; pos++; break;
+			case ']': current.type = LuaToken::right_bracket; pos++; break;
+			case '=': current.type = LuaToken::equals; pos++; break;
+			case ',':
+			case ';': current.type = LuaToken::separator; pos++; break;
+			case '-': current.type = LuaToken::minus; pos++; break;
+			case '"':
+			case '\'':
+				current.type = LuaToken::string;
+				current.text = LexQuotedString(c);
+				return;
+			case '[':
+			{
+				const std::size_t level = LongBracketLevel();
+				if (level != no_level)
+				{
+					current.type = LuaToken::string;
+					current.text = LexLongString(level, "Unfinished long string.");
+					return;
+				}
+				if (pos + 1 < source.size() && source[pos + 1] == '=')
+				{
+					Fail(current, "Invalid long string delimiter.");
+				}
+				current.type = LuaToken::left_bracket;
+				pos++;
+			}
+			break;
+			default:
+				if (IsDigit(c) || (c == '.' && pos + 1 < source.size() && IsDigit(source[pos + 1])))
+				{
+					LexNumber();
+				}
+				else if (IsNameStart(c))
+				{
+					current.type = LuaToken::name;
+					while (!AtEnd() && IsNameChar(source[pos])) pos++;
+				}
+				else
+				{
+					Fail(current, std::string("Unexpected symbol '") + c + "'.");
+				}
+			}
+			current.text = source.substr(start, pos - start);
+		}
+
+		// Only finds where the numeral ends, it is converted by whoever reads it
+		void LexNumber()
+		{
+			current.type = LuaToken::number;
+			char exponent[2] = { 'e', 'E' };
+			if (source[pos] == '0' && pos + 1 < source.size() && (source[pos + 1] == 'x' || source[pos + 1] == 'X'))
+			{
+				exponent[0] = 'p';
+				exponent[1] = 'P';
+				pos += 2;
+			}
+			while (!AtEnd())
+			{
+				const char c = source[pos];
+				if (c == exponent[0] || c == exponent[1])
+				{
+					pos++;
+					if (!AtEnd() && (source[pos] == '+' || source[pos] == '-')) pos++;
+				}
+				else if (HexValue(c) >= 0 || c == '.')
+				{
+					pos++;
+				}
+				else
+				{
+					break;
+				}
+			}
+			// Letters glued to a numeral make it malformed instead of starting a new token
+			while (!AtEnd() && IsNameChar(source[pos])) pos++;
+		}
+
+		std::string_view LexLongString(std::size_t level, const char* unfinished)
+		{
+			const std::size_t start_line = line;
+			const std::size_t start_column = Column();
+			pos += level + 2;
+			// A line break right after the opening bracket is not part of the string
+			if (!AtEnd() && (source[pos] == '\n' || source[pos] == '\r')) SkipNewLine();
+
+			const std::size_t content_start = pos;
+			bool plain_line_breaks = true;
+			while (true)
+			{
+				if (AtEnd()) Fail(start_line, start_column, unfinished);
+				const char c = source[pos];
+				if (c == ']')
+				{
+					std::size_t closing = 0;
+					while (pos + 1 + closing < source.size() && source[pos + 1 + closing] == '=') closing++;
+					if (closing == level && pos + 1 + closing < source.size() && source[pos + 1 + closing] == ']')
+					{
+						break;
+					}
+					pos++;
+				}
+				else if (c == '\n' || c == '\r')
+				{
+					const std::size_t before = pos;
+					SkipNewLine();
+					if (c != '\n' || pos - before != 1) plain_line_breaks = false;
+				}
+				else
+				{
+					pos++;
+				}
+			}
+			const std::string_view content = source.substr(content_start, pos - content_start);
+			pos += level + 2;
+			if (plain_line_breaks) return content;
+
+			// Every kind of line break reads as "\n"
+			scratch.clear();
+			for (std::size_t i = 0; i < content.size(); i++)
+			{
+				const char c = content[i];
+				if (c == '\n' || c == '\r')
+				{
+					if (i + 1 < content.size() && (content[i + 1] == '\n' || content[i + 1] == '\r') && content[i + 1] != c) i++;
+					scratch.push_back('\n');
+				}
+				else
+				{
+					scratch.push_back(c);
+				}
+			}
+			return scratch;
+		}
+
+		std::string_view LexQuotedString(char quote)
+		{
+			const std::size_t start_line = line;
+			const std::size_t start_column = Column();
+			pos++;
+			const std::size_t content_start = pos;
+
+			// Strings without escape sequences are returned as they are in the source
+			while (!AtEnd() && source[pos] != '\\')
+			{
+				const char c = source[pos];
+				if (c == quote)
+				{
+					pos++;
+					return source.substr(content_start, pos - 1 - content_start);
+				}
+				if (c == '\n' || c == '\r') Fail(start_line, start_column, "Unfinished string.");
+				pos++;
+			}
+
+			scratch.assign(source.substr(content_start, pos - content_start));
+			while (true)
+			{
+				if (AtEnd()) Fail(start_line, start_column, "Unfinished string.");
+				const char c = source[pos];
+				if (c == quote)
+				{
+					pos++;
+					return scratch;
+				}
+				if (c == '\n' || c == '\r') Fail(start_line, start_column, "Unfinished string.");
+				if (c != '\\')
+				{
+					scratch.push_back(c);
+					pos++;
+					continue;
+				}
+
+				pos++;
+				if (AtEnd()) Fail(start_line, start_column, "Unfinished string.");
+				const char escape = source[pos];
+				switch (escape)
+				{
+				case 'a': scratch.push_back('\a'); pos++; break;
+				case 'b': scratch.push_back('\b'); pos++; break;
+				case 'f': scratch.push_back('\f'); pos++; break;
+				case 'n': scratch.push_back('\n'); pos++; break;
+				case 'r': scratch.push_back('\r'); pos++; break;
+				case 't': scratch.push_back('\t'); pos++; break;
+				case 'v': scratch.push_back('\v'); pos++; break;
+				case '\\':
+				case '"':
+				case '\'':
+					scratch.push_back(escape);
+					pos++;
+					break;
+				case '\n':
+				case '\r':
+					scratch.push_back('\n');
+					SkipNewLine();
+					break;
+				case 'x':
+				{
+					pos++;
+					const int high = pos < source.size() ? HexValue(source[pos]) : -1;
+					const int low = pos + 1 < source.size() ? HexValue(source[pos + 1]) : -1;
+					if (high < 0 || low < 0) Fail(line, Column(), "Hexadecimal digit expected.");
+					scratch.push_back(static_cast<char>(high * 16 + low));
+					pos += 2;
+				}
+				break;
+				case 'z':
+					pos++;
+					while (!AtEnd())
+					{
+						const char skipped = source[pos];
+						if (skipped == '\n' || skipped == '\r') SkipNewLine();
+						else if (skipped == ' ' || skipped == '\t' || skipped == '\v' || skipped == '\f') pos++;
+						else break;
+					}
+					break;
+				case 'u':
+					LexUTF8Escape();
+					break;
+				default:
+				{
+					if (!IsDigit(escape)) Fail(line, Column(), "Invalid escape sequence.");
+					int value = 0;
+					for (int digits = 0; digits < 3 && !AtEnd() && IsDigit(source[pos]); digits++)
+					{
+						value = value * 10 + (source[pos] - '0');
+						pos++;
+					}
+					if (value > 255) Fail(line, Column(), "Decimal escape too large.");
+					scratch.push_back(static_cast<char>(value));
+				}
+				}
+			}
+		}
+
+		// Encodes "\u{XXX}" the same way Lua does, which allows code points up to 2^31
+		void LexUTF8Escape()
+		{
+			pos++;
+			if (AtEnd() || source[pos] != '{') Fail(line, Column(), "Missing '{' in \\u{xxxx}.");
+			pos++;
+			std::uint32_t code_point = 0;
+			std::size_t digits = 0;
+			while (!AtEnd() && HexValue(source[pos]) >= 0)
+			{
+				code_point = code_point * 16 + HexValue(source[pos]);
+				if (code_point > 0x7FFFFFFFu) Fail(line, Column(), "UTF-8 value too large.");
+				digits++;
+				pos++;
+			}
+			if (digits == 0) Fail(line, Column(), "Hexadecimal digit expected.");
+			if (AtEnd() || source[pos] != '}') Fail(line, Column(), "Missing '}' in \\u{xxxx}.");
+			pos++;
+
+			if (code_point < 0x80)
+			{
+				scratch.push_back(static_cast<char>(code_point));
+				return;
+			}
+			char buffer[8];
+			std::size_t count = 1;
+			std::uint32_t first_byte_max = 0x3f;
+			do
+			{
+				buffer[8 - count++] = static_cast<char>(0x80 | (code_point & 0x3f));
+				code_point >>= 6;
+				first_byte_max >>= 1;
+			} while (code_point > first_byte_max);
+			buffer[8 - count] = static_cast<char>((~first_byte_max << 1) | code_point);
+			scratch.append(buffer + 8 - count, count);
+		}
+	};
+
+	struct LuaFieldKey
+	{
+		bool is_name = false;
+		std::string_view name; // Only valid during the callback that receives the key
+		std::int64_t index = 0; // Positional values get the next array index, starting at 1
+	};
+
+	struct LuaNumber
+	{
+		bool is_integer = false;
+		std::int64_t integer = 0;
+		double real = 0;
+
+		double AsDouble() const { return is_integer ? double(integer) : real; }
+	};
+
+	// Reads the board straight out of the token stream, the only intermediate storage being the Posts themselves
+	class LuaBoardTableReader
+	{
+	public:
+		LuaBoardTableReader(std::string_view source, LoadProgress* progress) : lexer(source), progress(progress) {}
+
+		PostContainer Read()
+		{
+			if (lexer.Peek().type == LuaToken::name && lexer.Peek().text == "return") lexer.Skip();
+
+			const Token start = lexer.Peek();
+			if (start.type != LuaToken::left_brace) lexer.Fail(start, "Expected a table.");
+
+			PostContainer container;
+			// Posts and connections are applied together once the whole file was read
+			PostContainer::Batch batch(container);
+			std::vector<PostID> ids;
+			std::vector<ConnectionEntry> connections;
+			bool has_posts = false;
+
+			ReadTable([&](const LuaFieldKey& key)
+			{
+				if (!key.is_name)
+				{
+					SkipValue();
+				}
+				else if (key.name == "posts")
+				{
+					// A repeated key replaces the earlier value, like it does in Lua
+					batch.Rollback();
+					ids.clear();
+					ReadPosts(batch, ids);
+					has_posts = true;
+				}
+				else if (key.name == "board_config")
+				{
+					ReadBoardConfig(container.board_options.color_table);
+				}
+				else if (key.name == "connections")
+				{
+					ReadConnections(connections);
+				}
+				else
+				{
+					SkipValue();
+				}
+			});
+
+			if (lexer.Peek().type == LuaToken::separator && lexer.Peek().text == ";") lexer.Skip();
+			const Token& last = lexer.Peek();
+			if (last.type != LuaToken::end) lexer.Fail(last, "Expected the end of the file.");
+			if (!has_posts) lexer.Fail(start, "The file does not have a Posts table.");
+
+			for (const ConnectionEntry& connection : connections)
+			{
+				if (connection.from < 1 || connection.to < 1 || connection.from > std::int64_t(ids.size()) || connection.to > std::int64_t(ids.size()))
+				{
+					lexer.Fail(connection.line, connection.column, "Connection refers to a Post that does not exist.");
+				}
+				// The file stores positions, the container links Posts by ID
+				batch.Connect(ids[connection.from - 1], ids[connection.to - 1]);
+			}
+
+			batch.Commit();
+			return container;
+		}
+
+	private:
+		using Token = LuaTableLexer::Token;
+
+		struct ConnectionEntry
+		{
+			std::int64_t from;
+			std::int64_t to;
+			std::size_t line;
+			std::size_t column;
+		};
+
+		static constexpr std::size_t max_depth = 200;
+
+		LuaTableLexer lexer;
+		LoadProgress* progress;
+		std::size_t depth = 0;
+
+		static bool IsValueName(std::string_view name) { return name == "true" || name == "false" || name == "nil"; }
+
+		void Expect(LuaToken type, const char* what)
+		{
+			const Token& token = lexer.Peek();
+			if (token.type != type) FailUnexpected(token, what);
+			lexer.Skip();
+		}
+
+		[[noreturn]] void FailUnexpected(const Token& token, const char* expected)
+		{
+			if (token.type == LuaToken::end) lexer.Fail(token, std::string("Expected ") + expected + " but the file ended.");
+			lexer.Fail(token, std::string("Expected ") + expected + " near '" + std::string(token.text) + "'.");
+		}
+
+		// Calls on_field once for every field with a non-nil value; on_field must read that value
+		template<typename OnField>
+		void ReadTable(OnField&& on_field)
+		{
+			const Token& open = lexer.Peek();
+			if (++depth > max_depth) lexer.Fail(open, "Tables are nested too deeply.");
+			Expect(LuaToken::left_brace, "'{'");
+
+			std::int64_t next_position = 1;
+			std::string bracket_key;
+			while (lexer.Peek().type != LuaToken::right_brace)
+			{
+				const Token& token = lexer.Peek();
+				LuaFieldKey key;
+				if (token.type == LuaToken::left_bracket)
+				{
+					lexer.Skip();
+					const Token& key_token = lexer.Peek();
+					if (key_token.type == LuaToken::string)
+					{
+						bracket_key.assign(key_token.text);
+						key.is_name = true;
+						key.name = bracket_key;
+						lexer.Skip();
+					}
+					else
+					{
+						const Token position = key_token;
+						const LuaNumber number = ReadNumber("Expected a string or an integer key.");
+						// Lua turns float keys with an integral value into integers
+						if (!number.is_integer && std::trunc(number.real) != number.real) lexer.Fail(position, "Expected a string or an integer key.");
+						key.index = number.is_integer ? number.integer : std::int64_t(number.real);
+					}
+					Expect(LuaToken::right_bracket, "']'");
+					Expect(LuaToken::equals, "'='");
+				}
+				else if (token.type == LuaToken::name && !IsValueName(token.text))
+				{
+					key.is_name = true;
+					key.name = token.text;
+					lexer.Skip();
+					Expect(LuaToken::equals, "'='");
+				}
+				else
+				{
+					key.index = next_position++;
+				}
+
+				const Token& value = lexer.Peek();
+				if (value.type == LuaToken::name && value.text == "nil")
+				{
+					lexer.Skip(); // A nil value leaves the field unset
+				}
+				else
+				{
+					on_field(key);
+				}
+
+				const Token& after = lexer.Peek();
+				if (after.type == LuaToken::separator) lexer.Skip();
+				else if (after.type != LuaToken::right_brace) FailUnexpected(after, "'}' or a field separator");
+			}
+			lexer.Skip();
+			depth--;
+		}
+
+		// Calls on_item for every value of the sequence, in order; named fields are skipped since they are not part of it
+		template<typename OnItem>
+		void ReadArray(OnItem&& on_item)
+		{
+			std::int64_t expected = 1;
+			ReadTable([&](const LuaFieldKey& key)
+			{
+				if (key.is_name)
+				{
+					SkipValue();
+					return;
+				}
+				if (key.index != expected) lexer.Fail(lexer.Peek(), "Sequences cannot have holes or out of order indices.");
+				expected++;
+				on_item();
+			});
+		}
+
+		void SkipValue()
+		{
+			const Token& token = lexer.Peek();
+			switch (token.type)
+			{
+			case LuaToken::left_brace:
+				ReadTable([this](const LuaFieldKey&) { SkipValue(); });
+				break;
+			case LuaToken::minus:
+			case LuaToken::number:
+				ReadNumber();
+				break;
+			case LuaToken::string:
+				lexer.Skip();
+				break;
+			case LuaToken::name:
+				if (!IsValueName(token.text)) lexer.Fail(token, "Unexpected name '" + std::string(token.text) + "'.");
+				lexer.Skip();
+				break;
+			default:
+				FailUnexpected(token, "a value");
+			}
+		}
+
+		static bool ConvertNumber(std::string_view text, LuaNumber& number)
+		{
+			const char* end = text.data() + text.size();
+			if (text.size() > 1 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+			{
+				const std::string_view digits = text.substr(2);
+				if (digits.find_first_of(".pP") == std::string_view::npos)
+				{
+					// Hexadecimal integers wrap around instead of turning into floats, like in Lua
+					if (digits.empty()) return false;
+					std::uint64_t value = 0;
+					for (const char c : digits)
+					{
+						const int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+						if (digit < 0) return false;
+						value = value * 16 + std::uint64_t(digit);
+					}
+					number.is_integer = true;
+					number.integer = static_cast<std::int64_t>(value);
+					return true;
+				}
+				const auto [ptr, ec] = std::from_chars(digits.data(), end, number.real, std::chars_format::hex);
+				return ec == std::errc() && ptr == end;
+			}
+
+			if (text.find_first_of(".eE") == std::string_view::npos)
+			{
+				const auto [ptr, ec] = std::from_chars(text.data(), end, number.integer);
+				if (ec == std::errc() && ptr == end)
+				{
+					number.is_integer = true;
+					return true;
+				}
+				// Decimal integers too large for 64 bits are read as floats
+				if (ec != std::errc::result_out_of_range) return false;
+			}
+			const auto [ptr, ec] = std::from_chars(text.data(), end, number.real);
+			if (ptr != end) return false;
+			// from_chars leaves the value untouched when it overflows, strtod saturates to infinity or zero like Lua
+			if (ec == std::errc::result_out_of_range) number.real = std::strtod(std::string(text).c_str(), nullptr);
+			return ec == std::errc() || ec == std::errc::result_out_of_range;
+		}
+
+		LuaNumber ReadNumber(const char* error = "Expected a number.")
+		{
+			bool negative = false;
+			if (lexer.Peek().type == LuaToken::minus)
+			{
+				negative = true;
+				lexer.Skip();
+			}
+			const Token& token = lexer.Peek();
+			if (token.type != LuaToken::number) lexer.Fail(token, error);
+
+			LuaNumber number;
+			if (!ConvertNumber(token.text, number)) lexer.Fail(token, "Malformed number '" + std::string(token.text) + "'.");
+			lexer.Skip();
+
+			if (negative)
+			{
+				if (number.is_integer) number.integer = static_cast<std::int64_t>(0 - static_cast<std::uint64_t>(number.integer));
+				else number.real = -number.real;
+			}
+			return number;
+		}
+
+		// Accepts floats with an integral value, the way Lua compares them
+		std::int64_t ReadInteger(const char* error)
+		{
+			const Token position = lexer.Peek();
+			const LuaNumber number = ReadNumber(error);
+			if (number.is_integer) return number.integer;
+			if (std::trunc(number.real) != number.real || number.real < double(INT64_MIN) || number.real >= -double(INT64_MIN)) lexer.Fail(position, error);
+			return std::int64_t(number.real);
+		}
+
+		void ReadPosts(PostContainer::Batch& batch, std::vector<PostID>& ids)
+		{
+			const Token& token = lexer.Peek();
+			if (token.type != LuaToken::left_brace) lexer.Fail(token, "The file does not have a Posts table.");
+			ReadArray([&]()
+			{
+				ids.push_back(batch.InsertBack(ReadPost()));
+				if (progress && ids.size() % LoadProgress::report_interval == 0)
+				{
+					progress->ThrowIfCancelled();
+					progress->Report(lexer.Fraction());
+				}
+			});
+		}
+
+		Post ReadPost()
+		{
+			const Token start = lexer.Peek();
+			if (start.type != LuaToken::left_brace) lexer.Fail(start, "Post has no valid 'content' field.");
+
+			Post post;
+			post.content.Clear();
+			bool has_content = false;
+			ReadTable([&](const LuaFieldKey& key)
+			{
+				if (!key.is_name)
+				{
+					SkipValue();
+				}
+				else if (key.name == "content")
+				{
+					ReadContent(post);
+					has_content = true;
+				}
+				else if (key.name == "tags")
+				{
+					ReadTags(post.tags);
+				}
+				else if (key.name == "color")
+				{
+					ReadPostColor(post.color);
+				}
+				else if (key.name == "display_pos")
+				{
+					ReadDisplayPos(post.display_pos);
+				}
+				else
+				{
+					SkipValue();
+				}
+			});
+
+			if (!has_content) lexer.Fail(start, "Post has no valid 'content' field.");
+			return post;
+		}
+
+		void ReadContent(Post& post)
+		{
+			post.content.Clear();
+			const Token& token = lexer.Peek();
+			if (token.type == LuaToken::string)
+			{
+				post.content.EmplaceBack(std::string(token.text));
+				lexer.Skip();
+				return;
+			}
+			if (token.type != LuaToken::left_brace) lexer.Fail(token, "Post has no valid 'content' field.");
+
+			ReadArray([&]()
+			{
+				const Token& item = lexer.Peek();
+				if (item.type != LuaToken::string) lexer.Fail(item, "Post has no valid 'content' field.");
+				post.content.EmplaceBack(std::string(item.text));
+				lexer.Skip();
+			});
+		}
+
+		void ReadTags(Tags& tags)
+		{
+			const Token& token = lexer.Peek();
+			if (token.type != LuaToken::left_brace) lexer.Fail(token, "Post tags are not a table.");
+
+			tags = Tags();
+			ReadTable([&](const LuaFieldKey& key)
+			{
+				if (!key.is_name) lexer.Fail(lexer.Peek(), "Tag keys must be strings.");
+				const std::string name(key.name);
+				auto& entries = tags[name];
+				entries.Clear();
+				if (lexer.Peek().type == LuaToken::left_brace)
+				{
+					ReadArray([&]() { entries.EmplaceBack(ReadTagValue(name)); });
+				}
+				else
+				{
+					entries.EmplaceBack(ReadTagValue(name));
+				}
+			});
+		}
+
+		LuaValue::Variant ReadTagValue(const std::string& key)
+		{
+			const Token& token = lexer.Peek();
+			switch (token.type)
+			{
+			case LuaToken::string:
+			{
+				LuaValue::Variant value = std::string(token.text);
+				lexer.Skip();
+				return value;
+			}
+			case LuaToken::name:
+				if (token.text == "true" || token.text == "false")
+				{
+					LuaValue::Variant value = token.text == "true";
+					lexer.Skip();
+					return value;
+				}
+				break;
+			case LuaToken::minus:
+			case LuaToken::number:
+			{
+				// Lua integers become int Tags and every other number a float Tag
+				const LuaNumber number = ReadNumber();
+				if (number.is_integer) return int(number.integer);
+				return float(number.real);
+			}
+			default:
+				break;
+			}
+			lexer.Fail(token, ": Cannot parse '" + key + "' key: Unknown tag type.");
+		}
+
+		void ReadPostColor(float (&color)[3])
+		{
+			const Token start = lexer.Peek();
+			if (start.type != LuaToken::left_brace) lexer.Fail(start, "Post color is not valid.");
+
+			int values[3]{};
+			std::size_t count = 0;
+			ReadArray([&]()
+			{
+				const int value = int(ReadInteger("Post color is not valid."));
+				if (count < 3) values[count] = value;
+				count++;
+			});
+			if (count != 3) lexer.Fail(start, "Post color is not valid.");
+
+			color[0] = BoardColors::RGBIntToFloat(values[0]);
+			color[1] = BoardColors::RGBIntToFloat(values[1]);
+			color[2] = BoardColors::RGBIntToFloat(values[2]);
+		}
+
+		void ReadDisplayPos(std::pair<float, float>& display_pos)
+		{
+			const Token& token = lexer.Peek();
+			if (token.type != LuaToken::left_brace) lexer.Fail(token, "Post position is not valid.");
+
+			float values[2]{};
+			std::size_t count = 0;
+			ReadArray([&]()
+			{
+				const float value = float(ReadNumber("Post position is not valid.").AsDouble());
+				if (count < 2) values[count] = value;
+				count++;
+			});
+			// Positions with the wrong number of coordinates fall back to the origin
+			if (count == 2) display_pos = { values[0], values[1] };
+			else display_pos = { 0.f, 0.f };
+		}
+
+		void ReadBoardConfig(BoardColors& color_table)
+		{
+			const Token& token = lexer.Peek();
+			if (token.type != LuaToken::left_brace) lexer.Fail(token, "Board configuration is not a table.");
+
+			ReadTable([&](const LuaFieldKey& key)
+			{
+				if (!key.is_name) SkipValue();
+				else if (key.name == "bg_color") ReadBoardColor(color_table.bg);
+				else if (key.name == "post_color") ReadBoardColor(color_table.post);
+				else if (key.name == "connection_color") ReadBoardColor(color_table.connection);
+				else if (key.name == "selected_connection_color") ReadBoardColor(color_table.selected_connection);
+				else if (key.name == "text_color") ReadBoardColor(color_table.text);
+				else SkipValue();
+			});
+		}
+
+		void ReadBoardColor(float (&color)[3])
+		{
+			const Token start = lexer.Peek();
+			if (start.type != LuaToken::left_brace) lexer.Fail(start, "Board color is not valid.");
+
+			int values[3]{};
+			std::size_t count = 0;
+			ReadArray([&]()
+			{
+				const int value = int(ReadInteger("Board color is not valid."));
+				if (count < 3) values[count] = value;
+				count++;
+			});
+			if (count != 3) lexer.Fail(start, "Board color is not valid.");
+
+			color[0] = BoardColors::RGBIntToFloat(values[0]);
+			color[1] = BoardColors::RGBIntToFloat(values[1]);
+			color[2] = BoardColors::RGBIntToFloat(values[2]);
+		}
+
+		void ReadConnections(std::vector<ConnectionEntry>& connections)
+		{
+			const Token& token = lexer.Peek();
+			if (token.type != LuaToken::left_brace) lexer.Fail(token, "Connections are not a table.");
+
+			connections.clear();
+			// Every field counts, like the pairs() loop of ParsingStrategies::TableToContainer
+			ReadTable([&](const LuaFieldKey&)
+			{
+				const Token start = lexer.Peek();
+				if (start.type != LuaToken::left_brace) lexer.Fail(start, "Connection is not valid.");
+
+				std::int64_t ends[2]{};
+				std::size_t count = 0;
+				ReadArray([&]()
+				{
+					const std::int64_t end = ReadInteger("Connection is not valid.");
+					if (count < 2) ends[count] = end;
+					count++;
+				});
+				if (count < 2) lexer.Fail(start, "Connection is not valid.");
+				connections.push_back({ ends[0], ends[1], start.line, start.column });
+			});
+		}
+	};
+
+	PostContainer LuaBoardReader::Parse(std::string_view source, LoadProgress* progress)
+	{
+		return LuaBoardTableReader(source, progress).Read();
+	}
+
+	PostContainer LuaBoardReader::ParsePath(const std::string& path, LoadProgress* progress)
+	{
+		MappedFile file(path);
+		return Parse(std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), progress);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "containers/PostContainer.hpp"
+#include "utils/Error.hpp"
+#include "LoadProgress.hpp"
+
+namespace utils
+{
+	using board::PostContainer;
+
+	// Reads the Lua board format without a Lua state: a single pass over the text builds the PostContainer directly.
+	// Accepts the table literal subset that ParsingStrategies::ContainerToTable and serpent produce: nested tables,
+	// named and bracketed keys, strings with every Lua escape, long strings, numbers, booleans, nil and comments.
+	// The result matches ParsingStrategies::TableToContainer on the same text.
+	class LuaBoardReader
+	{
+	public:
+		// Throw ParsingError starting with the line and column of the first problem found.
+		// With a LoadProgress, also throw LoadCancelledError once its stop is requested.
+		static PostContainer Parse(std::string_view source, LoadProgress* progress = nullptr);
+		static PostContainer ParsePath(const std::string& path, LoadProgress* progress = nullptr);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,393 @@
+#include <algorithm> // std::sort
+#include <charconv> // std::to_chars
+#include <cmath> // std::isfinite
+#include <cstdint>
+#include <filesystem> // std::filesystem::rename
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "LuaBoardWriter.hpp"
+#include "utils/BoardColors.hpp"
+
+namespace utils
+{
+	using board::Post;
+	using board::PostID;
+	using board::PostContent;
+	using board::TagEntryList;
+
+	// Emits Lua table syntax with the same layout rules as serpent
+	class LuaTableWriter
+	{
+	public:
+		LuaTableWriter(std::ostream& out, LuaBoardWriter::Style style) : out(out), pretty(style == LuaBoardWriter::Style::pretty)
+		{
+			buffer.reserve(buffer_size);
+		}
+		~LuaTableWriter() { Flush(); }
+
+		void BeginTable()
+		{
+			buffer.push_back('{');
+			depth++;
+			has_fields = has_fields & ~(std::uint64_t(1) << depth);
+		}
+
+		void EndTable()
+		{
+			if (pretty && HasFields())
+			{
+				buffer.push_back('\n');
+				Indent(depth - 1);
+			}
+			buffer.push_back('}');
+			depth--;
+		}
+
+		// Starts a field of the current table; positional fields have no key
+		void Field()
+		{
+			if (HasFields()) buffer.push_back(',');
+			if (pretty)
+			{
+				buffer.push_back('\n');
+				Indent(depth);
+			}
+			has_fields |= std::uint64_t(1) << depth;
+		}
+
+		void Field(std::string_view key)
+		{
+			Field();
+			if (IsPlainName(key))
+			{
+				buffer.append(key);
+			}
+			else
+			{
+				buffer.push_back('[');
+				String(key);
+				buffer.push_back(']');
+			}
+			buffer.append(pretty ? " = " : "=");
+		}
+
+		void Integer(std::int64_t value)
+		{
+			char digits[24];
+			const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+			buffer.append(digits, end);
+			FlushIfFull();
+		}
+
+		// Formats like serpent's "%.17g"; values that are not finite are written as 0 since no reader accepts them
+		void Number(double value)
+		{
+			if (!std::isfinite(value)) value = 0;
+			char digits[32];
+			const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 17);
+			buffer.append(digits, end);
+			FlushIfFull();
+		}
+
+		void Bool(bool value)
+		{
+			buffer.append(value ? "true" : "false");
+		}
+
+		// Quotes like Lua's "%q", with the line break escape serpent substitutes
+		void String(std::string_view str)
+		{
+			buffer.push_back('"');
+			for (std::size_t i = 0; i < str.size(); i++)
+			{
+				const unsigned char c = static_cast<unsigned char>(str[i]);
+				if (c == '"' || c == '\\')
+				{
+					buffer.push_back('\\');
+					buffer.push_back(static_cast<char>(c));
+				}
+				else if (c == '\n')
+				{
+					buffer.append("\\n");
+				}
+				else if (c < 32 || c == 127)
+				{
+					// Padded to three digits when a digit follows, so the escape does not swallow it
+					const bool digit_follows = i + 1 < str.size() && str[i + 1] >= '0' && str[i + 1] <= '9';
+					char escape[5];
+					const int length = digit_follows ? 4 : (c < 10 ? 2 : c < 100 ? 3 : 4);
+					int value = c;
+					for (int d = length - 1; d > 0; d--)
+					{
+						escape[d] = static_cast<char>('0' + value % 10);
+						value /= 10;
+					}
+					escape[0] = '\\';
+					buffer.append(escape, length);
+				}
+				else
+				{
+					buffer.push_back(static_cast<char>(c));
+				}
+				FlushIfFull();
+			}
+			buffer.push_back('"');
+		}
+
+		void Flush()
+		{
+			out.write(buffer.data(), buffer.size());
+			buffer.clear();
+		}
+
+	private:
+		static constexpr std::size_t buffer_size = 1 << 16;
+		static constexpr std::string_view indent = "  ";
+
+		std::ostream& out;
+		const bool pretty;
+		std::string buffer;
+		std::uint32_t depth = 0;
+		std::uint64_t has_fields = 0; // One bit per open table, board tables are never nested 64 levels deep
+
+		bool HasFields() const { return (has_fields >> depth) & 1; }
+
+		void Indent(std::uint32_t level)
+		{
+			for (std::uint32_t i = 0; i < level; i++) buffer.append(indent);
+		}
+
+		void FlushIfFull()
+		{
+			if (buffer.size() >= buffer_size) Flush();
+		}
+
+		static bool IsPlainName(std::string_view name)
+		{
+			static constexpr std::string_view keywords[] = {
+				"and", "break", "do", "else", "elseif", "end", "false", "for", "function", "goto", "if", "in",
+				"local", "nil", "not", "or", "repeat", "return", "then", "true", "until", "while" };
+
+			if (name.empty()) return false;
+			const auto is_alpha = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; };
+			if (!is_alpha(name[0])) return false;
+			for (const char c : name)
+			{
+				if (!is_alpha(c) && !(c >= '0' && c <= '9')) return false;
+			}
+			return std::find(std::begin(keywords), std::end(keywords), name) == std::end(keywords);
+		}
+	};
+
+	// serpent sorts keys by their text with every run of digits padded to 12 characters
+	static void AppendSerpentSortKey(std::string_view key, std::string& sort_key)
+	{
+		sort_key.clear();
+		std::size_t i = 0;
+		while (i < key.size())
+		{
+			if (key[i] < '0' || key[i] > '9')
+			{
+				sort_key.push_back(key[i++]);
+				continue;
+			}
+			std::size_t end = i;
+			while (end < key.size() && key[end] >= '0' && key[end] <= '9') end++;
+			std::size_t first = i;
+			while (first + 1 < end && key[first] == '0') first++; // tonumber drops leading zeros
+			const std::size_t length = end - first;
+			if (length < 12) sort_key.append(12 - length, '0');
+			sort_key.append(key.substr(first, length));
+			i = end;
+		}
+	}
+
+	static void WriteColor(LuaTableWriter& writer, const float (&color)[3])
+	{
+		writer.BeginTable();
+		for (const float channel : color)
+		{
+			writer.Field();
+			writer.Integer(BoardColors::RGBFloatToInt(channel));
+		}
+		writer.EndTable();
+	}
+
+	void LuaBoardWriter::Write(const PostContainer& container, std::ostream& out, Style style)
+	{
+		LuaTableWriter writer(out, style);
+
+		// Posts are written bottom to top so the stacking order survives a reload.
+		// Connections come first in the file and refer to those positions, so they are looked up by slot.
+		std::uint32_t slot_count = 0;
+		for (PostID id = container.Bottom(); !id.IsNull(); id = container.Above(id))
+		{
+			slot_count = std::max(slot_count, id.slot + 1);
+		}
+		std::vector<std::uint32_t> file_positions(slot_count);
+		std::uint32_t file_position = 1;
+		for (PostID id = container.Bottom(); !id.IsNull(); id = container.Above(id))
+		{
+			file_positions[id.slot] = file_position++;
+		}
+
+		writer.BeginTable();
+
+		const auto& color_table = container.board_options.color_table;
+		writer.Field("board_config");
+		writer.BeginTable();
+		writer.Field("bg_color");
+		WriteColor(writer, color_table.bg);
+		writer.Field("connection_color");
+		WriteColor(writer, color_table.connection);
+		writer.Field("post_color");
+		WriteColor(writer, color_table.post);
+		writer.Field("selected_connection_color");
+		WriteColor(writer, color_table.selected_connection);
+		writer.Field("text_color");
+		WriteColor(writer, color_table.text);
+		writer.EndTable();
+
+		writer.Field("connections");
+		writer.BeginTable();
+		for (const PostContainer::PostConnection& connection : container.GetConnections())
+		{
+			writer.Field();
+			writer.BeginTable();
+			writer.Field();
+			writer.Integer(file_positions[connection.from.slot]);
+			writer.Field();
+			writer.Integer(file_positions[connection.to.slot]);
+			writer.EndTable();
+		}
+		writer.EndTable();
+
+		// Reused between Posts so sorting tag keys does not allocate once they reached their largest size
+		std::vector<std::pair<std::string, const TagEntryList*>> sorted_tags;
+		std::vector<std::string_view> tag_keys;
+		std::vector<std::size_t> order;
+
+		writer.Field("posts");
+		writer.BeginTable();
+		for (PostID id = container.Bottom(); !id.IsNull(); id = container.Above(id))
+		{
+			const Post& post = container[id];
+			writer.Field();
+			writer.BeginTable();
+
+			if (post.HasColor())
+			{
+				writer.Field("color");
+				WriteColor(writer, post.color);
+			}
+
+			writer.Field("content");
+			writer.BeginTable();
+			for (const PostContent& content : post.content)
+			{
+				if (content.GetType() != board::ContentType::text)
+				{
+					throw SerializingError("Cannot serialize unknown ContentType");
+				}
+				writer.Field();
+				writer.String(content.AsString());
+			}
+			writer.EndTable();
+
+			writer.Field("display_pos");
+			writer.BeginTable();
+			writer.Field();
+			writer.Number(post.display_pos.first);
+			writer.Field();
+			writer.Number(post.display_pos.second);
+			writer.EndTable();
+
+			if (!post.tags.Empty())
+			{
+				std::size_t tag_count = 0;
+				tag_keys.clear();
+				for (const auto& [key, entries] : post.tags)
+				{
+					if (sorted_tags.size() <= tag_count) sorted_tags.emplace_back();
+					AppendSerpentSortKey(key, sorted_tags[tag_count].first);
+					sorted_tags[tag_count].second = &entries;
+					tag_keys.push_back(key);
+					tag_count++;
+				}
+				order.clear();
+				for (std::size_t i = 0; i < tag_count; i++) order.push_back(i);
+				std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) { return sorted_tags[lhs].first < sorted_tags[rhs].first; });
+
+				writer.Field("tags");
+				writer.BeginTable();
+				for (const std::size_t i : order)
+				{
+					writer.Field(tag_keys[i]);
+					writer.BeginTable();
+					for (const LuaValue& entry : *sorted_tags[i].second)
+					{
+						writer.Field();
+						switch (entry.index())
+						{
+						case 0:
+							writer.Integer(entry.asInt());
+							break;
+						case 1:
+							writer.Number(entry.asFloat());
+							break;
+						case 2:
+							writer.Bool(entry.asBool());
+							break;
+						case 3:
+							writer.String(entry.asString());
+							break;
+						}
+					}
+					writer.EndTable();
+				}
+				writer.EndTable();
+			}
+
+			writer.EndTable();
+		}
+		writer.EndTable();
+
+		writer.EndTable();
+		writer.Flush();
+	}
+
+	std::string LuaBoardWriter::ToString(const PostContainer& container, Style style)
+	{
+		std::ostringstream out;
+		Write(container, out, style);
+		return out.str();
+	}
+
+	// Write streams the board as it walks it and can throw halfway, so it writes next to the target and only replaces it once done
+	void LuaBoardWriter::ToFile(const PostContainer& container, const std::string& path, Style style)
+	{
+		const std::string temporary_path = path + ".tmp";
+		try
+		{
+			{
+				std::ofstream file(temporary_path, std::fstream::out);
+				if (!file) throw FileWriteError("Could not open " + temporary_path + " for writing.");
+				Write(container, file, style);
+				file.close();
+				if (!file) throw FileWriteError("Could not write to " + temporary_path + ".");
+			}
+			std::error_code error;
+			std::filesystem::rename(temporary_path, path, error);
+			if (error) throw FileWriteError("Could not replace " + path + ": " + error.message());
+		}
+		catch (...)
+		{
+			std::error_code ignored;
+			std::filesystem::remove(temporary_path, ignored);
+			throw;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "containers/PostContainer.hpp"
+#include "utils/Error.hpp"
+
+namespace utils
+{
+	using board::PostContainer;
+
+	// Writes the Lua board format straight from a PostContainer, without building a Lua table first.
+	// The text goes through a fixed-size buffer into the stream. The only other memory that grows with the board is one
+	// 32-bit file position per Post slot, needed because connections are written before the Posts they refer to.
+	class LuaBoardWriter
+	{
+	public:
+		enum class Style
+		{
+			pretty, // Same bytes as serpent.block over ParsingStrategies::ContainerToTable
+			compact // Same bytes as serpent.line with the compact option, on a single line
+		};
+
+		// Throw SerializingError if a Post holds content that the Lua format cannot store
+		static void Write(const PostContainer& container, std::ostream& out, Style style = Style::pretty);
+		static std::string ToString(const PostContainer& container, Style style = Style::pretty);
+		static void ToFile(const PostContainer& container, const std::string& path, Style style = Style::pretty); // Leaves an existing file untouched if it throws
+	};
+}
\ No newline at end of file
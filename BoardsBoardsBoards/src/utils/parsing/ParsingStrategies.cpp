@@ -1,3 +1,5 @@
+#include <unordered_map>
+
 #include "ParsingStrategies.hpp"
 
 
@@ -145,15 +147,15 @@ namespace utils
 		sol::table posts_table = posts;
 		std::size_t raw_size = posts_table.size();
 		PostContainer container;
-		container.Resize(raw_size);
+		// Posts and connections are applied together once the whole table was read
+		PostContainer::Batch batch(container);
+		std::vector<PostID> ids;
+		ids.reserve(raw_size);
 
 		for (std::size_t i = 1; i <= raw_size; i++)
 		{
 			sol::object obj = posts_table[i];
-			Post new_post = ParsingStrategies::ObjectToPost(obj);
-			new_post.SetIdx(i);
-
-			container[i] = std::move(new_post);
+			ids.push_back(batch.InsertBack(ParsingStrategies::ObjectToPost(obj)));
 		}
 
 		sol::object config = table["board_config"];
@@ -227,20 +229,30 @@ namespace utils
 				sol::table pair = connection.second.as<sol::table>();
 				std::size_t from = pair[1];
 				std::size_t to = pair[2];
-				container.connections.EmplaceBack(from, to);
+				if (from == 0 || to == 0 || from > ids.size() || to > ids.size())
+				{
+					throw ParsingError("Connection refers to a Post that does not exist.");
+				}
+				// The file stores positions, the container links Posts by ID
+				batch.Connect(ids[from - 1], ids[to - 1]);
 			}
 		}
 
+		batch.Commit();
 		return container;
 	};
 
 	const ContainerIntoLuaTable ParsingStrategies::ContainerToTable = [](const PostContainer& container) -> sol::table
 	{
-		
+		// Posts are written bottom to top so the stacking order survives a reload
+		const std::vector<PostID> draw_order = container.GetDrawOrder();
+		std::unordered_map<PostID, std::size_t> file_positions;
+
 		sol::table posts_table = LuaStack::EmptyTable();
-		for (std::size_t i = 1; i <= container.size(); i++)
+		for (std::size_t i = 1; i <= draw_order.size(); i++)
 		{
-			const Post& post = container[i];
+			const Post& post = container[draw_order[i - 1]];
+			file_positions[draw_order[i - 1]] = i;
 
 			posts_table[i] = LuaStack::EmptyTable();
 			sol::table curr = posts_table[i];
@@ -330,11 +342,11 @@ namespace utils
 		board_config["text_color"][3] = color_table.RGBFloatToInt(text_color[2]);
 
 		sol::table connections = LuaStack::EmptyTable();
-		for (const PostContainer::PostConnection& connection : container.connections)
+		for (const PostContainer::PostConnection& connection : container.GetConnections())
 		{
 			sol::table c = LuaStack::EmptyTable();
-			c[1] = connection.from;
-			c[2] = connection.to;
+			c[1] = file_positions[connection.from];
+			c[2] = file_positions[connection.to];
 			connections.add(c);
 		}
 
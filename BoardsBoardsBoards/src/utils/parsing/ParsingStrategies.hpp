@@ -13,6 +13,7 @@ namespace utils
 {
 	using board::PostContainer;
 	using board::Post;
+	using board::PostID;
 	using board::LuaVector;
 	using board::PostContent;
 	using board::ContentType;
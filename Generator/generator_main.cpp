@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <cstdlib> // std::strtod, std::strtoul
+#include <cstring> // std::strcmp
+#include <string>
+
+#include "utils/BoardGenerator.hpp"
+#include "utils/Error.hpp"
+
+using utils::BoardGenerator;
+
+static void PrintUsage(const char* program)
+{
+	std::printf("Usage: %s --out PATH [options]\n\n", program);
+	std::printf("Writes a synthetic board, the extension of PATH picks the format (.lua or the binary one).\n\n");
+	std::printf("  --posts N            Posts on the board (1000)\n");
+	std::printf("  --seed N             Same seed and options, same board (1)\n");
+	std::printf("  --lines MIN MAX      Text contents per Post (1 2)\n");
+	std::printf("  --content NAME       Line lengths: fixed, uniform or long_tail (long_tail)\n");
+	std::printf("  --characters N       Mean characters per line (60)\n");
+	std::printf("  --tags X             Mean tags per Post (1)\n");
+	std::printf("  --graph NAME         Connections: none, random, tree or scale_free (random)\n");
+	std::printf("  --connections X      Mean connections per Post, for random and scale_free (1)\n");
+	std::printf("  --branching N        Children per Post, for tree (3)\n");
+	std::printf("  --layout NAME        Positions: grid, random or clustered (grid)\n");
+	std::printf("  --spacing X          Board units between neighbouring Posts (250)\n");
+}
+
+int main(int argc, char** argv)
+{
+	BoardGenerator::Options options;
+	std::string path;
+
+	try
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const bool has_value = i + 1 < argc;
+			if (has_value && std::strcmp(argv[i], "--out") == 0) path = argv[++i];
+			else if (has_value && std::strcmp(argv[i], "--posts") == 0) options.posts = std::strtoul(argv[++i], nullptr, 10);
+			else if (has_value && std::strcmp(argv[i], "--seed") == 0) options.seed = std::uint32_t(std::strtoul(argv[++i], nullptr, 10));
+			else if (i + 2 < argc && std::strcmp(argv[i], "--lines") == 0)
+			{
+				options.min_lines = std::strtoul(argv[++i], nullptr, 10);
+				options.max_lines = std::strtoul(argv[++i], nullptr, 10);
+			}
+			else if (has_value && std::strcmp(argv[i], "--content") == 0) options.content_size = BoardGenerator::ContentSizeFromName(argv[++i]);
+			else if (has_value && std::strcmp(argv[i], "--characters") == 0) options.mean_characters = std::strtoul(argv[++i], nullptr, 10);
+			else if (has_value && std::strcmp(argv[i], "--tags") == 0) options.tags_per_post = std::strtod(argv[++i], nullptr);
+			else if (has_value && std::strcmp(argv[i], "--graph") == 0) options.graph = BoardGenerator::GraphFromName(argv[++i]);
+			else if (has_value && std::strcmp(argv[i], "--connections") == 0) options.connections_per_post = std::strtod(argv[++i], nullptr);
+			else if (has_value && std::strcmp(argv[i], "--branching") == 0) options.branching = std::strtoul(argv[++i], nullptr, 10);
+			else if (has_value && std::strcmp(argv[i], "--layout") == 0) options.layout = BoardGenerator::LayoutFromName(argv[++i]);
+			else if (has_value && std::strcmp(argv[i], "--spacing") == 0) options.spacing = float(std::strtod(argv[++i], nullptr));
+			else
+			{
+				PrintUsage(argv[0]);
+				return 1;
+			}
+		}
+		if (path.empty())
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+
+		BoardGenerator::GenerateFile(options, path);
+	}
+	catch (const utils::Error& e)
+	{
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+
+	std::printf("Wrote %zu Posts (%s graph, %s layout, seed %u) to %s\n", options.posts,
+		BoardGenerator::Name(options.graph), BoardGenerator::Name(options.layout), unsigned(options.seed), path.c_str());
+	return 0;
+}
\ No newline at end of file
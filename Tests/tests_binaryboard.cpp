@@ -0,0 +1,251 @@
+#include <cstdio> // std::remove
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "utils/parsing/BinaryBoardFormat.hpp"
+#include "utils/parsing/BoardParser.hpp"
+#include "containers/PostContainer.hpp"
+#include "utils/LuaStack.hpp"
+
+using utils::BinaryBoardFormat;
+using utils::BoardParser;
+using utils::LuaStack;
+using utils::LuaValue;
+using board::PostContainer;
+using board::PostID;
+using board::Post;
+using std::string;
+using std::vector;
+
+const string tag = "[BinaryBoardFormat]";
+
+// Testing helpers
+PostContainer SampleContainer()
+{
+	PostContainer container;
+	auto first = container.CreatePostBack("First post.");
+	first->display_pos = { 10.5f, -20.25f };
+	first->content.EmplaceBack("Second content, shared.");
+	first->tags["numbers"].EmplaceBack(-7);
+	first->tags["numbers"].EmplaceBack(3.75f);
+	first->tags["flags"].EmplaceBack(true);
+	first->tags["flags"].EmplaceBack(false);
+	first->tags["words"].EmplaceBack(LuaValue::Variant(string("true")));
+
+	auto second = container.CreatePostBack("Second content, shared.");
+	second->color[0] = 0.5f;
+	second->color[1] = 0.25f;
+	second->color[2] = 1.f;
+	second->content.EmplaceBack("images/cat.png", "A cat.");
+	second->tags["numbers"].EmplaceBack(42);
+
+	container.CreatePostBack("");
+	container.board_options.color_table.bg[0] = 0.123f;
+
+	container.Connect(container.IDAt(1), container.IDAt(2));
+	container.Connect(container.IDAt(3), container.IDAt(1));
+	return container;
+}
+
+vector<string> FirstContentsInDrawOrder(const PostContainer& container)
+{
+	vector<string> contents;
+	for (PostID id = container.Bottom(); !id.IsNull(); id = container.Above(id))
+	{
+		contents.push_back(container[id].content[1].AsString());
+	}
+	return contents;
+}
+
+SCENARIO("A PostContainer survives a round trip through the binary format", tag)
+{
+	GIVEN("A PostContainer with contents, tags, colors and connections")
+	{
+		const PostContainer container = SampleContainer();
+
+		WHEN("It is serialized and parsed back")
+		{
+			const vector<unsigned char> serialized = BinaryBoardFormat::Serialize(container);
+			const PostContainer parsed = BinaryBoardFormat::Parse(serialized.data(), serialized.size());
+
+			THEN("The parsed container is equal to the original")
+			{
+				REQUIRE(BinaryBoardFormat::IsBinaryBoard(serialized.data(), serialized.size()));
+				REQUIRE(parsed == container);
+				REQUIRE(parsed[1].tags["words"][1] == "true");
+				REQUIRE(parsed[2].content[2].IsImageInfo());
+				REQUIRE(parsed.IsConnected(parsed.IDAt(3), parsed.IDAt(1)));
+			}
+		}
+
+		WHEN("A Post is raised before serializing")
+		{
+			PostContainer raised = container;
+			raised.RaiseToTop(raised.IDAt(1));
+			const vector<unsigned char> serialized = BinaryBoardFormat::Serialize(raised);
+			const PostContainer parsed = BinaryBoardFormat::Parse(serialized.data(), serialized.size());
+
+			THEN("The draw order and the connections are kept")
+			{
+				REQUIRE(FirstContentsInDrawOrder(parsed) == FirstContentsInDrawOrder(raised));
+				REQUIRE(parsed.GetConnections().size() == 2);
+				const PostID first = parsed.IDAt(3);
+				const PostID second = parsed.IDAt(1);
+				const PostID third = parsed.IDAt(2);
+				REQUIRE(parsed.IsConnected(first, second));
+				REQUIRE(parsed.IsConnected(third, first));
+			}
+		}
+
+		WHEN("It is saved to disk and read back through BoardParser")
+		{
+			const string path = "binary_board_test.board";
+			BoardParser parser;
+			parser.SavePath(container, path);
+			const PostContainer parsed = parser.LoadPath(path);
+			std::remove(path.c_str());
+
+			THEN("The file is mapped and parsed without going through Lua")
+			{
+				REQUIRE(parsed == container);
+			}
+		}
+	}
+}
+
+SCENARIO("A board read from the Lua format survives a round trip through the binary format", tag)
+{
+	GIVEN("A PostContainer parsed from a Lua script")
+	{
+		LuaStack::Init();
+
+		BoardParser parser;
+
+		const string sample_board = R"({
+  board_config = {
+    bg_color = {
+      119,
+      119,
+      119
+    },
+    text_color = {
+      223,
+      187,
+      187
+    }
+  },
+  connections = {
+    {
+      1,
+      2
+    },
+    {
+      2,
+      3
+    }
+  },
+  posts = {
+    {
+      content = {
+        "Testing serialization and deserialization.\n\nThis post has 1 connection."
+      },
+      display_pos = {
+        325,
+        251
+      },
+      tags = {
+        maybe = {
+          false,
+          true
+        },
+        random = {
+          5,
+          7,
+          8
+        },
+        sometext = {
+          "Random text."
+        }
+      }
+    },
+    {
+      color = {
+        127,
+        20,
+        20
+      },
+      content = {
+        "This post is red."
+      },
+      display_pos = {
+        742,
+        373
+      }
+    },
+    {
+      content = {
+        "This post has no connections at all."
+      },
+      display_pos = {
+        290,
+        413
+      }
+    }
+  }
+})";
+
+		const PostContainer from_lua = parser.Parse(LuaStack::DeserializeTableString(sample_board));
+
+		WHEN("It is converted to the binary format and back")
+		{
+			const vector<unsigned char> serialized = BinaryBoardFormat::Serialize(from_lua);
+			const PostContainer from_binary = BinaryBoardFormat::Parse(serialized.data(), serialized.size());
+
+			THEN("Both formats describe the same board")
+			{
+				REQUIRE(from_binary == from_lua);
+				REQUIRE(parser.Parse(parser.ToTable(from_binary)) == from_lua);
+			}
+		}
+	}
+}
+
+SCENARIO("Invalid binary boards are rejected", tag)
+{
+	GIVEN("A valid serialized board")
+	{
+		const vector<unsigned char> serialized = BinaryBoardFormat::Serialize(SampleContainer());
+
+		THEN("Data without the magic bytes is not a binary board")
+		{
+			const string lua_board = "{ posts = {} }";
+			const auto* data = reinterpret_cast<const unsigned char*>(lua_board.data());
+			REQUIRE_FALSE(BinaryBoardFormat::IsBinaryBoard(data, lua_board.size()));
+			REQUIRE_THROWS_AS(BinaryBoardFormat::Parse(data, lua_board.size()), utils::ParsingError);
+		}
+
+		THEN("Truncated data throws")
+		{
+			REQUIRE_THROWS_AS(BinaryBoardFormat::Parse(serialized.data(), serialized.size() - 1), utils::ParsingError);
+			REQUIRE_THROWS_AS(BinaryBoardFormat::Parse(serialized.data(), 12), utils::ParsingError);
+		}
+
+		THEN("An unknown version throws")
+		{
+			vector<unsigned char> newer = serialized;
+			newer[8] = BinaryBoardFormat::version + 1;
+			REQUIRE_THROWS_WITH(BinaryBoardFormat::Parse(newer.data(), newer.size()), "Binary board version 2 is not supported.");
+		}
+
+		THEN("A connection to a Post that does not exist throws")
+		{
+			vector<unsigned char> corrupted = serialized;
+			const std::size_t string_bytes = corrupted[36] | (corrupted[37] << 8);
+			const std::size_t last_connection_to = corrupted.size() - string_bytes - 4;
+			corrupted[last_connection_to] = 200;
+			REQUIRE_THROWS_WITH(BinaryBoardFormat::Parse(corrupted.data(), corrupted.size()), "Connection refers to a Post that does not exist.");
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include <algorithm> // std::count, std::max_element
+#include <cmath> // std::sqrt
+#include <cstdio> // std::remove
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "containers/PostContainer.hpp"
+#include "utils/BoardGenerator.hpp"
+#include "utils/Error.hpp"
+#include "utils/LuaStack.hpp"
+#include "utils/parsing/BoardParser.hpp"
+
+using std::string;
+
+using board::PostContainer;
+using board::PostID;
+using utils::BinaryBoardFormat;
+using utils::BoardGenerator;
+using utils::BoardGeneratorError;
+using utils::BoardParser;
+using utils::LuaStack;
+using Graph = utils::BoardGenerator::Graph;
+using Layout = utils::BoardGenerator::Layout;
+
+const string tag = "[BoardGenerator]";
+
+// Testing helpers
+static std::vector<std::size_t> IncomingCounts(const PostContainer& container)
+{
+	std::vector<std::size_t> counts;
+	for (std::size_t i = 1; i <= container.size(); i++)
+	{
+		counts.push_back(container.Incoming(container.IDAt(i)).size());
+	}
+	return counts;
+}
+
+SCENARIO("The generator builds the same board for the same seed", tag)
+{
+	GIVEN("Options for a small board")
+	{
+		BoardGenerator::Options options;
+		options.posts = 300;
+		options.tags_per_post = 2.0;
+
+		WHEN("The board is generated twice with the same seed")
+		{
+			const PostContainer first = BoardGenerator::Generate(options);
+			const PostContainer second = BoardGenerator::Generate(options);
+
+			THEN("Both boards are equal and have the requested Posts")
+			{
+				REQUIRE(first.size() == 300);
+				REQUIRE(first == second);
+				REQUIRE(first.GetConnections().size() == second.GetConnections().size());
+			}
+		}
+
+		WHEN("The seed changes")
+		{
+			const PostContainer first = BoardGenerator::Generate(options);
+			options.seed = 2;
+			const PostContainer second = BoardGenerator::Generate(options);
+
+			THEN("The boards differ")
+			{
+				REQUIRE(second.size() == 300);
+				REQUIRE_FALSE(first == second);
+			}
+		}
+	}
+}
+
+SCENARIO("The generator shapes content, connections and positions as asked", tag)
+{
+	GIVEN("Options for 1000 Posts")
+	{
+		BoardGenerator::Options options;
+		options.posts = 1000;
+
+		WHEN("Lines have a fixed length and a fixed count")
+		{
+			options.content_size = BoardGenerator::ContentSize::fixed;
+			options.mean_characters = 40;
+			options.min_lines = 3;
+			options.max_lines = 3;
+			const PostContainer container = BoardGenerator::Generate(options);
+
+			THEN("Every Post has three lines of 40 characters")
+			{
+				for (const auto& post : container)
+				{
+					REQUIRE(post.content.size() == 3);
+					for (const auto& line : post.content) REQUIRE(line.AsString().size() == 40);
+				}
+			}
+		}
+
+		WHEN("The graph is a tree")
+		{
+			options.graph = Graph::tree;
+			options.branching = 4;
+			const PostContainer container = BoardGenerator::Generate(options);
+
+			THEN("Every Post but the root has exactly one parent")
+			{
+				const std::vector<std::size_t> incoming = IncomingCounts(container);
+				REQUIRE(container.GetConnections().size() == 999);
+				REQUIRE(incoming[0] == 0);
+				REQUIRE(std::count(incoming.begin() + 1, incoming.end(), 1) == 999);
+				REQUIRE(container.Outgoing(container.IDAt(1)).size() == 4);
+			}
+		}
+
+		WHEN("The graph is scale free")
+		{
+			options.graph = Graph::scale_free;
+			options.connections_per_post = 2.0;
+			const PostContainer container = BoardGenerator::Generate(options);
+
+			THEN("A few Posts gather far more connections than the mean")
+			{
+				const std::vector<std::size_t> incoming = IncomingCounts(container);
+				const double mean = double(container.GetConnections().size()) / double(container.size());
+				REQUIRE(mean > 1.5);
+				REQUIRE(double(*std::max_element(incoming.begin(), incoming.end())) > 10.0 * mean);
+			}
+		}
+
+		WHEN("The graph is random")
+		{
+			options.connections_per_post = 1.5;
+			const PostContainer container = BoardGenerator::Generate(options);
+
+			THEN("It has the requested number of connections")
+			{
+				REQUIRE(container.GetConnections().size() == 1500);
+			}
+		}
+
+		WHEN("Posts are laid out on a grid")
+		{
+			options.layout = Layout::grid;
+			options.spacing = 100.f;
+			const PostContainer container = BoardGenerator::Generate(options);
+
+			THEN("They fill 32 columns at the given spacing")
+			{
+				REQUIRE(container[1].display_pos == std::pair<float, float>(0.f, 0.f));
+				REQUIRE(container[2].display_pos == std::pair<float, float>(100.f, 0.f));
+				REQUIRE(container[33].display_pos == std::pair<float, float>(0.f, 100.f));
+			}
+		}
+
+		WHEN("Posts are laid out at random or in clusters")
+		{
+			options.spacing = 100.f;
+			const float side = std::sqrt(1000.f) * 100.f;
+			for (const Layout layout : { Layout::random, Layout::clustered })
+			{
+				options.layout = layout;
+				const PostContainer container = BoardGenerator::Generate(options);
+
+				THEN("No Post is placed at negative coordinates")
+				{
+					for (const auto& post : container)
+					{
+						REQUIRE(post.display_pos.first >= 0.f);
+						REQUIRE(post.display_pos.second >= 0.f);
+						if (layout == Layout::random)
+						{
+							REQUIRE(post.display_pos.first < side);
+							REQUIRE(post.display_pos.second < side);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Generated boards survive a round trip through every board format", tag)
+{
+	GIVEN("A generated board with tags, colors and connections")
+	{
+		LuaStack::Init();
+		BoardGenerator::Options options;
+		options.posts = 500;
+		options.tags_per_post = 2.0;
+		options.colored_fraction = 0.5;
+		const PostContainer container = BoardGenerator::Generate(options);
+
+		for (const string& extension : { string("lua"), string(BinaryBoardFormat::extension) })
+		{
+			WHEN("It is written to a ." + extension + " file and read back")
+			{
+				const string path = (std::filesystem::temp_directory_path() / ("generated_board." + extension)).string();
+				BoardGenerator::GenerateFile(options, path);
+				const PostContainer parsed = BoardParser().LoadPath(path);
+				std::remove(path.c_str());
+
+				THEN("The parsed board equals the generated one")
+				{
+					REQUIRE(parsed == container);
+					REQUIRE(parsed.GetConnections().size() == container.GetConnections().size());
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("The generator refuses contradictory options", tag)
+{
+	GIVEN("Default options")
+	{
+		BoardGenerator::Options options;
+
+		THEN("Contradictions throw BoardGeneratorError")
+		{
+			options.min_lines = 3;
+			options.max_lines = 2;
+			REQUIRE_THROWS_AS(BoardGenerator::Generate(options), BoardGeneratorError);
+
+			options = BoardGenerator::Options();
+			options.posts = 10;
+			options.connections_per_post = 10.0;
+			REQUIRE_THROWS_AS(BoardGenerator::Generate(options), BoardGeneratorError);
+
+			options = BoardGenerator::Options();
+			options.branching = 0;
+			REQUIRE_THROWS_AS(BoardGenerator::Generate(options), BoardGeneratorError);
+		}
+
+		THEN("Names map back to their values and unknown names throw")
+		{
+			REQUIRE(BoardGenerator::GraphFromName(BoardGenerator::Name(Graph::scale_free)) == Graph::scale_free);
+			REQUIRE(BoardGenerator::LayoutFromName("clustered") == Layout::clustered);
+			REQUIRE_THROWS_AS(BoardGenerator::GraphFromName("ring"), BoardGeneratorError);
+		}
+	}
+}
\ No newline at end of file
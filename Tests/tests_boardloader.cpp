@@ -0,0 +1,169 @@
+#include <chrono>
+#include <cstdio> // std::remove
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "utils/parsing/BoardLoader.hpp"
+#include "utils/parsing/BoardParser.hpp"
+#include "utils/parsing/LuaBoardReader.hpp"
+#include "utils/parsing/LuaBoardWriter.hpp"
+#include "containers/PostContainer.hpp"
+#include "utils/WorkerPool.hpp"
+
+using utils::BoardLoader;
+using utils::BoardParser;
+using utils::LoadProgress;
+using utils::LuaBoardReader;
+using utils::LuaBoardWriter;
+using utils::WorkerPool;
+using board::PostContainer;
+using std::string;
+using std::vector;
+
+const string tag = "[BoardLoader]";
+
+// Testing helpers
+PostContainer LoaderSampleContainer(std::size_t post_count)
+{
+	PostContainer container;
+	for (std::size_t i = 0; i < post_count; i++)
+	{
+		auto post = container.CreatePostBack("Post " + std::to_string(i));
+		post->display_pos = { float(i), float(i * 2) };
+	}
+	container.Connect(container.IDAt(1), container.IDAt(post_count));
+	return container;
+}
+
+void WaitUntilDone(const BoardLoader& loader)
+{
+	while (!loader.Done()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+SCENARIO("BoardLoader parses boards on another thread", tag)
+{
+	GIVEN("A board saved in both formats")
+	{
+		const PostContainer container = LoaderSampleContainer(1000);
+		const string lua_path = "board_loader_test.lua";
+		const string binary_path = "board_loader_test.board";
+		BoardParser().SavePath(container, lua_path);
+		BoardParser().SavePath(container, binary_path);
+
+		WHEN("Both files are loaded")
+		{
+			BoardLoader lua_loader(lua_path);
+			BoardLoader binary_loader(binary_path);
+			WaitUntilDone(lua_loader);
+			WaitUntilDone(binary_loader);
+
+			THEN("The loaders hand back the same board as a synchronous parse")
+			{
+				REQUIRE(lua_loader.Progress() == 1.f);
+				REQUIRE(lua_loader.Take() == BoardParser().LoadPath(lua_path));
+				REQUIRE(binary_loader.Take() == container);
+				REQUIRE_THROWS_AS(binary_loader.Take(), utils::BoardLoadError);
+			}
+		}
+
+		std::remove(lua_path.c_str());
+		std::remove(binary_path.c_str());
+	}
+
+	GIVEN("A path that does not exist")
+	{
+		BoardLoader loader("board_loader_missing.lua");
+		WaitUntilDone(loader);
+
+		THEN("Taking the result rethrows the error of the worker")
+		{
+			REQUIRE_THROWS_AS(loader.Take(), utils::FileOpenError);
+		}
+	}
+}
+
+SCENARIO("Many boards load at once through a small WorkerPool", tag)
+{
+	GIVEN("More board files than pool threads")
+	{
+		WorkerPool pool(2);
+		vector<string> paths;
+		for (std::size_t i = 0; i < 8; i++)
+		{
+			paths.push_back("board_loader_pool_test_" + std::to_string(i) + ".lua");
+			BoardParser().SavePath(LoaderSampleContainer(100 + i), paths.back());
+		}
+
+		WHEN("A loader is created for each of them")
+		{
+			vector<std::unique_ptr<BoardLoader>> loaders;
+			for (const string& path : paths) loaders.push_back(std::make_unique<BoardLoader>(path, pool));
+			for (const auto& loader : loaders) WaitUntilDone(*loader);
+
+			THEN("Every loader hands back its own board")
+			{
+				for (std::size_t i = 0; i < loaders.size(); i++)
+				{
+					REQUIRE(loaders[i]->Path() == paths[i]);
+					REQUIRE(loaders[i]->Take().size() == 100 + i);
+				}
+			}
+		}
+
+		WHEN("A loader is cancelled before the pool gets to it")
+		{
+			std::unique_ptr<BoardLoader> loader;
+			{
+				WorkerPool busy(1);
+				busy.Submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+				loader = std::make_unique<BoardLoader>(paths.front(), busy);
+				loader->Cancel();
+				WaitUntilDone(*loader);
+			}
+
+			THEN("It finishes without parsing the file")
+			{
+				REQUIRE_THROWS_AS(loader->Take(), utils::LoadCancelledError);
+			}
+		}
+
+		for (const string& path : paths) std::remove(path.c_str());
+	}
+}
+
+SCENARIO("Parsers stop once the load is cancelled", tag)
+{
+	GIVEN("A board with more Posts than a progress report interval")
+	{
+		const string board = LuaBoardWriter::ToString(LoaderSampleContainer(LoadProgress::report_interval * 4));
+
+		WHEN("It is parsed with a LoadProgress")
+		{
+			LoadProgress progress;
+			LuaBoardReader::Parse(board, &progress);
+
+			THEN("Progress was reported along the way")
+			{
+				REQUIRE(progress.Fraction() > 0.5f);
+				REQUIRE(progress.Fraction() <= 1.f);
+			}
+		}
+
+		WHEN("It is parsed after the stop was requested")
+		{
+			std::stop_source stop;
+			LoadProgress progress(stop.get_token());
+			stop.request_stop();
+
+			THEN("The parse throws LoadCancelledError")
+			{
+				REQUIRE_THROWS_AS(LuaBoardReader::Parse(board, &progress), utils::LoadCancelledError);
+			}
+		}
+	}
+}
\ No newline at end of file
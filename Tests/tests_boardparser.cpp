@@ -1,4 +1,6 @@
+#include <cstdio> // std::remove
 #include <string>
+#include <thread>
 
 #include "catch.hpp"
 
@@ -10,6 +12,7 @@ using utils::LuaStack;
 using utils::BoardParser;
 using board::PostContainer;
 using std::string;
+using utils::ScriptParser;
 
 const string tag = "[BoardParser]";
 
@@ -309,4 +312,71 @@ SCENARIO("A deserialized PostContainer is equal to the original", tag)
 
         REQUIRE(posts == other_posts);
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Lua boards can be parsed on several threads at once", tag)
+{
+    GIVEN("A board saved to disk")
+    {
+        LuaStack::Init();
+
+        PostContainer original;
+        for (int i = 0; i < 200; i++)
+        {
+            original.CreatePostBack("Post " + std::to_string(i))->tags["index"].EmplaceBack(i);
+        }
+        original.Connect(original.IDAt(1), original.IDAt(200));
+
+        const string path = "board_parser_threads_test.lua";
+        BoardParser().SavePath(original, path);
+
+        WHEN("Two threads parse it through the Lua state at the same time")
+        {
+            PostContainer results[2];
+            lua_State* states[2] = {};
+            {
+                std::jthread first([&]() { results[0] = BoardParser().ParsePath(path); states[0] = LuaStack::EmptyTable().lua_state(); });
+                std::jthread second([&]() { results[1] = BoardParser().ParsePath(path); states[1] = LuaStack::EmptyTable().lua_state(); });
+            }
+            const PostContainer on_this_thread = BoardParser().ParsePath(path);
+            std::remove(path.c_str());
+
+            THEN("The workers did not use this thread's Lua state and got the same board")
+            {
+                // Both worker states are gone by now and may share an address, this thread's state is still alive
+                REQUIRE(states[0] != LuaStack::EmptyTable().lua_state());
+                REQUIRE(states[1] != LuaStack::EmptyTable().lua_state());
+                REQUIRE(results[0] == on_this_thread);
+                REQUIRE(results[1] == on_this_thread);
+                REQUIRE(results[0].IsConnected(results[0].IDAt(1), results[0].IDAt(200)));
+            }
+        }
+    }
+}
+
+SCENARIO("ParsePath uses the parsing strategy BoardParser was given, LoadPath does not", tag)
+{
+    GIVEN("A saved board and a BoardParser with a strategy that drops every Post")
+    {
+        PostContainer original;
+        original.CreatePostBack("Post");
+
+        const string path = "board_parser_strategy_test.lua";
+        BoardParser().SavePath(original, path);
+
+        BoardParser parser([](sol::table) { return PostContainer(); });
+
+        WHEN("The board is read through both paths")
+        {
+            const PostContainer through_strategy = parser.ParsePath(path);
+            const PostContainer native = parser.LoadPath(path);
+            std::remove(path.c_str());
+
+            THEN("Only ParsePath went through the strategy")
+            {
+                REQUIRE(through_strategy.Empty());
+                REQUIRE(native == original);
+            }
+        }
+    }
+}
@@ -0,0 +1,478 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "catch.hpp"
+#include "imgui.h"
+
+#include "containers/PostContainer.hpp"
+#include "renderables/HeadlessDriver.hpp"
+#include "renderables/tabs/BoardTab.hpp"
+#include "utils/AllocationCounter.hpp"
+#include "utils/BoardGenerator.hpp"
+
+using std::string;
+
+using board::BoardTab;
+using board::HeadlessDriver;
+using board::PostContainer;
+using board::PostID;
+using utils::AllocationCounter;
+using utils::BoardGenerator;
+
+const string tag = "[BoardTab]";
+
+// Testing helpers
+
+PostContainer MakeBoard(std::size_t count)
+{
+	PostContainer container;
+	PostID previous;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		auto it = container.CreatePostBack(i % 3 == 0 ? "" : "Post number " + std::to_string(i) + " with some text to lay out");
+		it->display_pos = { float(i % 20) * 150.f, float(i / 20) * 120.f }; // Most of them outside of the window
+		const PostID id = container.IDOf(it);
+		if (!previous.IsNull()) container.Connect(previous, id);
+		previous = id;
+	}
+	return container;
+}
+
+void Click(HeadlessDriver& driver, BoardTab& tab, ImVec2 pos, ImGuiMouseButton button = ImGuiMouseButton_Left)
+{
+	driver.MoveMouse(pos);
+	driver.PressMouse(button);
+	driver.Run(2, tab);
+	driver.ReleaseMouse(button);
+	driver.Run(2, tab);
+}
+
+void RightClick(HeadlessDriver& driver, BoardTab& tab, ImVec2 pos)
+{
+	Click(driver, tab, pos, ImGuiMouseButton_Right);
+}
+
+// Popups open at the mouse, with one line per menu item
+ImVec2 MenuItemPos(ImVec2 opened_at, int index)
+{
+	const ImGuiStyle& style = ImGui::GetStyle();
+	const float line = ImGui::GetFontSize() + style.ItemSpacing.y;
+	return opened_at + ImVec2(style.WindowPadding.x + 10.f, style.WindowPadding.y + line * float(index) + ImGui::GetFontSize() * 0.5f);
+}
+
+// Null unless the window was drawn in the last frame
+ImGuiWindow* EditPostWindow()
+{
+	ImGuiWindow* window = ImGui::FindWindowByName("Edit post");
+	return (window != nullptr && window->Active) ? window : nullptr;
+}
+
+SCENARIO("The allocation counter sees allocations made through new", tag)
+{
+	GIVEN("The count of the calling thread")
+	{
+		const std::uint64_t before = AllocationCounter::ThisThread();
+
+		WHEN("Something is allocated")
+		{
+			auto allocated = std::make_unique<int>(3);
+
+			THEN("The count grew")
+			{
+				REQUIRE(AllocationCounter::ThisThread() > before);
+			}
+		}
+	}
+}
+
+SCENARIO("An idle BoardTab renders frames without allocating", tag)
+{
+	GIVEN("A board whose Posts and connections were already laid out")
+	{
+		HeadlessDriver driver;
+		BoardTab tab(MakeBoard(400), "board.lua");
+		driver.Run(10, tab);
+
+		WHEN("More frames are rendered while nothing changes")
+		{
+			const HeadlessDriver::Report report = driver.Run(60, tab);
+
+			THEN("None of them touched the heap")
+			{
+				REQUIRE(report.Peak().allocations == 0);
+			}
+			THEN("The tab does not ask for them")
+			{
+				REQUIRE_FALSE(tab.NeedsRedraw());
+			}
+		}
+	}
+}
+
+SCENARIO("A large generated board stays idle once laid out", tag)
+{
+	GIVEN("A scale free board of clustered Posts with long tail text and tags")
+	{
+		BoardGenerator::Options options;
+		options.posts = 5000;
+		options.graph = BoardGenerator::Graph::scale_free;
+		options.connections_per_post = 2.0;
+		options.layout = BoardGenerator::Layout::clustered;
+		options.tags_per_post = 3.0;
+
+		HeadlessDriver driver;
+		BoardTab tab(BoardGenerator::Generate(options), "generated.lua");
+		driver.Run(10, tab);
+
+		WHEN("More frames are rendered while nothing changes")
+		{
+			const HeadlessDriver::Report report = driver.Run(30, tab);
+
+			THEN("They draw the visible Posts without touching the heap")
+			{
+				REQUIRE(report.frames.back().vertices > 0);
+				REQUIRE(report.Peak().allocations == 0);
+			}
+		}
+	}
+}
+
+SCENARIO("The headless driver measures what every frame drew", tag)
+{
+	GIVEN("An empty board and a board with many Posts")
+	{
+		HeadlessDriver driver;
+		BoardTab empty_tab(PostContainer(), "empty.lua");
+		BoardTab full_tab(MakeBoard(400), "board.lua");
+
+		WHEN("Both are rendered for a few frames")
+		{
+			const HeadlessDriver::Report empty = driver.Run(5, empty_tab);
+			const HeadlessDriver::Report full = driver.Run(5, full_tab);
+
+			THEN("Every frame is reported with its draw data")
+			{
+				REQUIRE(full.frames.size() == 5);
+				const HeadlessDriver::FrameStats& last = full.frames.back();
+				REQUIRE(last.draw_lists > 0);
+				REQUIRE(last.draw_commands > 0);
+				REQUIRE(last.vertices > 0);
+				REQUIRE(last.indices >= last.vertices);
+			}
+			THEN("Posts and connections add geometry")
+			{
+				REQUIRE(full.frames.back().vertices > empty.frames.back().vertices);
+				REQUIRE(full.frames.back().indices > empty.frames.back().indices);
+			}
+			THEN("The timings are ordered")
+			{
+				REQUIRE(full.Percentile(50.0) <= full.Percentile(95.0));
+				REQUIRE(full.Percentile(95.0) <= full.Peak().milliseconds);
+				REQUIRE_FALSE(full.Summary().empty());
+			}
+		}
+	}
+}
+
+SCENARIO("Synthetic input selects, drags and undoes like a user would", tag)
+{
+	GIVEN("Two connected Posts inside the window, clear of the windows Debug builds open at the top left")
+	{
+		HeadlessDriver driver;
+		PostContainer container;
+		const PostID first_id = container.IDOf(container.CreatePostBack("First"));
+		const PostID second_id = container.IDOf(container.CreatePostBack("Second"));
+		container[first_id].display_pos = { 800.f, 550.f };
+		container[second_id].display_pos = { 1050.f, 550.f };
+		container.Connect(first_id, second_id);
+
+		BoardTab tab(std::move(container), "board.lua");
+		driver.Run(3, tab);
+		REQUIRE(tab.container.GetDrawOrder().back() == second_id);
+
+		WHEN("The first Post is clicked")
+		{
+			driver.MoveMouse(ImVec2(805.f, 555.f));
+			driver.PressMouse();
+			driver.Run(2, tab);
+			driver.ReleaseMouse();
+			driver.Run(2, tab);
+
+			THEN("It is raised above the other one and nothing moved")
+			{
+				REQUIRE(tab.container.GetDrawOrder().back() == first_id);
+				REQUIRE(tab.container[first_id].display_pos == std::make_pair(800.f, 550.f));
+			}
+		}
+
+		WHEN("The first Post is dragged")
+		{
+			driver.MoveMouse(ImVec2(805.f, 555.f));
+			driver.PressMouse();
+			driver.Run(2, tab);
+			for (int step = 1; step <= 5; step++)
+			{
+				driver.MoveMouse(ImVec2(805.f + step * 10.f, 555.f + step * 6.f));
+				driver.RenderFrame(tab);
+			}
+			driver.ReleaseMouse();
+			driver.Run(2, tab);
+
+			THEN("It follows the mouse")
+			{
+				REQUIRE(tab.container[first_id].display_pos == std::make_pair(850.f, 580.f));
+				REQUIRE(tab.CanUndo());
+			}
+			AND_WHEN("Ctrl+Z is pressed")
+			{
+				driver.MoveMouse(ImVec2(1200.f, 700.f));
+				driver.PressKey(ImGuiKey_Z, true);
+				driver.Run(3, tab);
+
+				THEN("The whole drag is undone at once")
+				{
+					REQUIRE(tab.container[first_id].display_pos == std::make_pair(800.f, 550.f));
+					REQUIRE_FALSE(tab.CanUndo());
+					REQUIRE(tab.CanRedo());
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Edits made outside of the Edit post window survive its Cancel", tag)
+{
+	GIVEN("Two Posts, the first one open in the Edit post window")
+	{
+		HeadlessDriver driver;
+		PostContainer container;
+		const PostID first_id = container.IDOf(container.CreatePostBack("First"));
+		const PostID second_id = container.IDOf(container.CreatePostBack("Second"));
+		container[first_id].display_pos = { 800.f, 550.f };
+		container[second_id].display_pos = { 1050.f, 550.f };
+
+		BoardTab tab(std::move(container), "board.lua");
+		driver.Run(3, tab);
+		RightClick(driver, tab, ImVec2(805.f, 555.f));
+		Click(driver, tab, MenuItemPos(ImVec2(805.f, 555.f), 0)); // Edit Post
+		REQUIRE(EditPostWindow() != nullptr);
+
+		WHEN("The second Post is dragged")
+		{
+			driver.MoveMouse(ImVec2(1055.f, 555.f));
+			driver.PressMouse();
+			driver.Run(2, tab);
+			for (int step = 1; step <= 5; step++)
+			{
+				driver.MoveMouse(ImVec2(1055.f + step * 10.f, 555.f + step * 6.f));
+				driver.RenderFrame(tab);
+			}
+			driver.ReleaseMouse();
+			driver.Run(2, tab);
+
+			THEN("Clicking the board closed the window, keeping its edits, and the drag stays")
+			{
+				REQUIRE(EditPostWindow() == nullptr);
+				REQUIRE(tab.container[second_id].display_pos == std::make_pair(1100.f, 580.f));
+				REQUIRE(tab.CanUndo());
+			}
+		}
+
+		WHEN("A Post is added from the board's right click menu and the window is cancelled")
+		{
+			RightClick(driver, tab, ImVec2(700.f, 650.f));
+			Click(driver, tab, MenuItemPos(ImVec2(700.f, 650.f), 0)); // Add Post
+			REQUIRE(tab.container.size() == 3);
+			REQUIRE(EditPostWindow() != nullptr);
+
+			const ImGuiWindow* window = EditPostWindow();
+			const ImGuiStyle& style = ImGui::GetStyle();
+			Click(driver, tab, window->Pos + ImVec2(window->Size.x - style.FramePadding.x - ImGui::GetFontSize() * 0.5f, style.FramePadding.y + ImGui::GetFontSize() * 0.5f));
+
+			THEN("The window is closed and the new Post stays, as its own undo step")
+			{
+				REQUIRE(EditPostWindow() == nullptr);
+				REQUIRE(tab.container.size() == 3);
+				REQUIRE(tab.CanUndo());
+			}
+		}
+	}
+}
+
+SCENARIO("Undoing while a right click menu is open does not act on what the undo removed", tag)
+{
+	GIVEN("A Post added through the right click menu, then right clicked")
+	{
+		HeadlessDriver driver;
+		BoardTab tab(PostContainer(), "board.lua");
+		driver.Run(3, tab);
+		RightClick(driver, tab, ImVec2(800.f, 550.f));
+		Click(driver, tab, MenuItemPos(ImVec2(800.f, 550.f), 0)); // Add Post
+		REQUIRE(tab.container.size() == 1);
+
+		RightClick(driver, tab, ImVec2(805.f, 555.f));
+
+		WHEN("Ctrl+Z removes the Post and the menu's Remove Post is clicked")
+		{
+			driver.PressKey(ImGuiKey_Z, true);
+			driver.Run(3, tab);
+			REQUIRE(tab.container.Empty());
+
+			THEN("The menu is gone and nothing throws")
+			{
+				REQUIRE_NOTHROW(Click(driver, tab, MenuItemPos(ImVec2(805.f, 555.f), 1)));
+				REQUIRE(tab.container.Empty());
+				REQUIRE(tab.CanRedo());
+			}
+		}
+	}
+}
+
+SCENARIO("Zooming out draws Posts with less detail", tag)
+{
+	GIVEN("A board of Posts with several lines, zoomed out until it fits in the window")
+	{
+		BoardGenerator::Options options;
+		options.posts = 100;
+		options.min_lines = 2;
+		options.max_lines = 3;
+		options.content_size = BoardGenerator::ContentSize::fixed;
+		options.mean_characters = 20;
+
+		HeadlessDriver driver;
+		BoardTab tab(BoardGenerator::Generate(options), "generated.lua");
+		tab.SetZoom(0.25f);
+		driver.Run(5, tab);
+		REQUIRE(tab.GetZoom() == 0.25f);
+
+		WHEN("The same view is drawn at every level of detail")
+		{
+			tab.camera.titles_below = tab.camera.rects_below = 0.f;
+			const int full = driver.Run(3, tab).frames.back().vertices;
+			tab.camera.titles_below = 1.f;
+			const int titles = driver.Run(3, tab).frames.back().vertices;
+			tab.camera.rects_below = 1.f;
+			const HeadlessDriver::Report rects = driver.Run(3, tab);
+
+			THEN("Every level draws less than the one above it")
+			{
+				REQUIRE(titles < full);
+				REQUIRE(rects.frames.back().vertices < titles);
+			}
+			THEN("Switching levels does not need the text to be laid out again")
+			{
+				REQUIRE(rects.Peak().allocations == 0);
+				REQUIRE_FALSE(tab.NeedsRedraw());
+			}
+		}
+	}
+}
+
+SCENARIO("Synthetic input follows the camera", tag)
+{
+	GIVEN("Three Posts that fit in the window at zoom 1")
+	{
+		HeadlessDriver driver;
+		PostContainer container;
+		const PostID first_id = container.IDOf(container.CreatePostBack("First"));
+		const PostID second_id = container.IDOf(container.CreatePostBack("Second"));
+		const PostID third_id = container.IDOf(container.CreatePostBack("Third"));
+		container[first_id].display_pos = { 900.f, 300.f };
+		container[second_id].display_pos = { 1050.f, 550.f };
+		container[third_id].display_pos = { 1150.f, 650.f };
+
+		BoardTab tab(std::move(container), "board.lua");
+		driver.Run(3, tab);
+
+		WHEN("Ctrl + mouse wheel zooms in over the first Post, which is then clicked")
+		{
+			driver.MoveMouse(ImVec2(905.f, 305.f));
+			ImGui::GetIO().AddKeyEvent(ImGuiKey_ModCtrl, true);
+			driver.Run(1, tab);
+			driver.Wheel(0.f, 3.f);
+			driver.Run(2, tab);
+			ImGui::GetIO().AddKeyEvent(ImGuiKey_ModCtrl, false);
+			driver.Run(2, tab);
+
+			driver.PressMouse();
+			driver.Run(2, tab);
+			driver.ReleaseMouse();
+			driver.Run(2, tab);
+
+			THEN("The Post stayed under the mouse and was selected")
+			{
+				REQUIRE(tab.GetZoom() == Approx(1.331f));
+				REQUIRE(tab.container.GetDrawOrder().back() == first_id);
+			}
+		}
+
+		WHEN("The board is zoomed out and the second Post is dragged")
+		{
+			tab.SetZoom(0.5f);
+			driver.Run(2, tab);
+
+			driver.MoveMouse(ImVec2(530.f, 280.f)); // (1060, 560) on the board
+			driver.PressMouse();
+			driver.Run(2, tab);
+			for (int step = 1; step <= 5; step++)
+			{
+				driver.MoveMouse(ImVec2(530.f + step * 10.f, 280.f + step * 6.f));
+				driver.RenderFrame(tab);
+			}
+			driver.ReleaseMouse();
+			driver.Run(2, tab);
+
+			THEN("It moves twice as far on the board as the mouse did on screen")
+			{
+				REQUIRE(tab.container[second_id].display_pos == std::make_pair(1150.f, 610.f));
+			}
+		}
+	}
+}
+
+
+SCENARIO("Text layouts are cached until the text is edited", tag)
+{
+	GIVEN("A short Post below another one")
+	{
+		HeadlessDriver driver;
+		PostContainer container;
+		const PostID short_id = container.IDOf(container.CreatePostBack("A"));
+		const PostID other_id = container.IDOf(container.CreatePostBack("Other"));
+		container[short_id].display_pos = { 800.f, 550.f };
+		container[other_id].display_pos = { 1050.f, 650.f };
+
+		BoardTab tab(std::move(container), "board.lua");
+		driver.Run(3, tab);
+
+		const auto Click = [&](const ImVec2& pos)
+		{
+			driver.MoveMouse(pos);
+			driver.PressMouse();
+			driver.Run(2, tab);
+			driver.ReleaseMouse();
+			driver.Run(2, tab);
+		};
+
+		WHEN("Empty board right of its text is clicked")
+		{
+			Click(ImVec2(1000.f, 555.f));
+
+			THEN("Nothing is selected") { REQUIRE(tab.container.GetDrawOrder().back() == other_id); }
+		}
+
+		WHEN("Its text is edited to be longer and the same place is clicked")
+		{
+			tab.container[short_id].content[1].AsString() = "A line long enough to reach the click";
+			tab.container[short_id].content[1].Edited();
+			driver.Run(1, tab);
+			Click(ImVec2(1000.f, 555.f));
+
+			THEN("The Post was measured again and grew under the mouse")
+			{
+				REQUIRE(tab.container.GetDrawOrder().back() == short_id);
+			}
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "containers/BoundingVolumeHierarchy.hpp"
+
+using board::BoundingVolumeHierarchy;
+using std::string;
+using std::vector;
+
+const string tag = "[BoundingVolumeHierarchy]";
+
+// Testing helpers
+vector<ImRect> RandomRects(std::size_t count, unsigned int seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> position(-2000.f, 2000.f);
+	std::uniform_real_distribution<float> size(1.f, 300.f);
+
+	vector<ImRect> rects;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const float x = position(rng);
+		const float y = position(rng);
+		rects.emplace_back(x, y, x + size(rng), y + size(rng));
+	}
+	return rects;
+}
+
+vector<std::size_t> BruteForceQuery(const vector<ImRect>& rects, const ImRect& area)
+{
+	vector<std::size_t> result;
+	for (std::size_t i = 0; i < rects.size(); i++)
+	{
+		if (rects[i].Overlaps(area)) result.push_back(i);
+	}
+	return result;
+}
+
+vector<std::size_t> Sorted(vector<std::size_t> items)
+{
+	std::sort(items.begin(), items.end());
+	return items;
+}
+
+SCENARIO("Queries report the same items as checking every rectangle", tag)
+{
+	GIVEN("A tree built over many random rectangles")
+	{
+		vector<ImRect> rects = RandomRects(1000, 42);
+		BoundingVolumeHierarchy tree;
+		tree.Build(rects);
+
+		REQUIRE(tree.size() == 1000);
+
+		WHEN("Areas and points are queried")
+		{
+			THEN("Every overlapping item is reported once")
+			{
+				for (const ImRect& area : RandomRects(50, 7))
+				{
+					vector<std::size_t> result;
+					tree.QueryRect(area, result);
+					REQUIRE(Sorted(result) == BruteForceQuery(rects, area));
+				}
+
+				const ImVec2 point = rects[10].GetCenter();
+				vector<std::size_t> result;
+				tree.QueryPoint(point, result);
+				REQUIRE(std::find(result.begin(), result.end(), 10) != result.end());
+				for (std::size_t item : result)
+				{
+					REQUIRE(rects[item].Contains(point));
+				}
+			}
+		}
+		WHEN("Items are refit to new places")
+		{
+			vector<ImRect> moved = RandomRects(100, 99);
+			for (std::size_t i = 0; i < moved.size(); i++)
+			{
+				rects[i * 10] = moved[i];
+				tree.Refit(i * 10, moved[i]);
+			}
+
+			THEN("Queries follow them")
+			{
+				for (const ImRect& area : RandomRects(50, 8))
+				{
+					vector<std::size_t> result;
+					tree.QueryRect(area, result);
+					REQUIRE(Sorted(result) == BruteForceQuery(rects, area));
+				}
+			}
+		}
+		WHEN("The tree is cleared")
+		{
+			tree.Clear();
+
+			THEN("Nothing is reported")
+			{
+				vector<std::size_t> result;
+				tree.QueryRect(ImRect(-5000.f, -5000.f, 5000.f, 5000.f), result);
+				REQUIRE(result.empty());
+				REQUIRE(tree.Empty());
+			}
+		}
+	}
+}
\ No newline at end of file
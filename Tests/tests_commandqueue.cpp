@@ -0,0 +1,138 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "containers/MPSCQueue.hpp"
+#include "utils/CommandQueue.hpp"
+#include "utils/FrameWake.hpp"
+
+using board::MPSCQueue;
+using board::CommandQueue;
+using std::string;
+using std::vector;
+
+const string tag = "[CommandQueue]";
+
+// Testing helpers
+using ProducerItem = std::pair<std::size_t, std::size_t>; // Producer, sequence number
+
+std::atomic<int> wake_requests = 0;
+void CountWake() { wake_requests++; }
+
+SCENARIO("MPSCQueue keeps every item of concurrent producers in order", tag)
+{
+	GIVEN("Several threads pushing into one queue while it is being popped")
+	{
+		constexpr std::size_t producer_count = 4;
+		constexpr std::size_t items_per_producer = 20000;
+		MPSCQueue<ProducerItem> queue;
+
+		vector<std::thread> producers;
+		for (std::size_t p = 0; p < producer_count; p++)
+		{
+			producers.emplace_back([&queue, p]()
+			{
+				for (std::size_t i = 0; i < items_per_producer; i++) queue.Push({ p, i });
+			});
+		}
+
+		vector<std::size_t> next_expected(producer_count, 0);
+		std::size_t popped = 0;
+		bool in_order = true;
+		while (popped < producer_count * items_per_producer)
+		{
+			const auto item = queue.TryPop();
+			if (!item) continue;
+			const auto [producer, sequence] = *item;
+			in_order = in_order && sequence == next_expected[producer];
+			next_expected[producer] = sequence + 1;
+			popped++;
+		}
+		for (std::thread& producer : producers) producer.join();
+
+		THEN("Every item comes out once, in the order its producer pushed it")
+		{
+			REQUIRE(in_order);
+			REQUIRE(next_expected == vector<std::size_t>(producer_count, items_per_producer));
+			REQUIRE(!queue.TryPop());
+		}
+	}
+}
+
+SCENARIO("CommandQueue drains a bounded number of typed commands", tag)
+{
+	GIVEN("More commands than a single drain handles")
+	{
+		const std::size_t pushed = CommandQueue::max_drain + 10;
+		for (std::size_t i = 0; i < pushed; i++)
+		{
+			CommandQueue::Push(CommandQueue::targets::applicationLayer, CommandQueue::OpenFiles{ { std::to_string(i) } });
+		}
+		CommandQueue::Push(CommandQueue::targets::currentTab, CommandQueue::OpenBoardOptions{});
+
+		WHEN("The target is drained frame after frame")
+		{
+			vector<string> paths;
+			const auto collect = [&paths](const CommandQueue::Command& command)
+			{
+				paths.push_back(std::get<CommandQueue::OpenFiles>(command).paths.front());
+			};
+			const std::size_t first = CommandQueue::Drain(CommandQueue::targets::applicationLayer, collect);
+			const std::size_t second = CommandQueue::Drain(CommandQueue::targets::applicationLayer, collect);
+			const std::size_t third = CommandQueue::Drain(CommandQueue::targets::applicationLayer, collect);
+
+			std::size_t options = 0;
+			CommandQueue::Drain(CommandQueue::targets::currentTab, [&options](const CommandQueue::Command& command)
+			{
+				if (std::holds_alternative<CommandQueue::OpenBoardOptions>(command)) options++;
+			});
+
+			THEN("Each frame handles at most max_drain commands, in the order they were pushed")
+			{
+				REQUIRE(first == CommandQueue::max_drain);
+				REQUIRE(second == 10);
+				REQUIRE(third == 0);
+				REQUIRE(paths.size() == pushed);
+				REQUIRE(paths.front() == "0");
+				REQUIRE(paths.back() == std::to_string(pushed - 1));
+			}
+
+			THEN("Other targets keep their own commands")
+			{
+				REQUIRE(options == 1);
+			}
+		}
+	}
+}
+
+SCENARIO("Pushing a command wakes the UI thread until the command is drained", tag)
+{
+	GIVEN("A wake function installed by the application")
+	{
+		for (auto target : { CommandQueue::targets::applicationLayer, CommandQueue::targets::widgetManager, CommandQueue::targets::currentTab })
+		{
+			while (CommandQueue::Drain(target, [](const CommandQueue::Command&) {}) > 0) {} // Left over by other tests
+		}
+		utils::FrameWake::Install(CountWake);
+		wake_requests = 0;
+
+		WHEN("Another thread pushes a command")
+		{
+			std::thread([]() { CommandQueue::CreateErrorWindow("From a worker"); }).join();
+
+			THEN("The wait is ended and the command stays pending until it is drained")
+			{
+				REQUIRE(wake_requests == 1);
+				REQUIRE(CommandQueue::Pending());
+
+				CommandQueue::Drain(CommandQueue::targets::widgetManager, [](const CommandQueue::Command&) {});
+				REQUIRE_FALSE(CommandQueue::Pending());
+			}
+		}
+		utils::FrameWake::Install(nullptr);
+	}
+}
\ No newline at end of file
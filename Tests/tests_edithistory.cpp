@@ -0,0 +1,394 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "containers/EditHistory.hpp"
+#include "containers/PostContainer.hpp"
+#include "utils/Error.hpp"
+
+using std::string;
+
+using board::EditHistory;
+using board::Post;
+using board::PostContainer;
+using board::PostID;
+
+const string tag = "[EditHistory]";
+
+// Testing helpers
+
+// Everything Undo has to give back, IDs included
+struct Snapshot
+{
+	Snapshot(const PostContainer& container) : container(container), draw_order(container.GetDrawOrder())
+	{
+		for (std::size_t i = 1; i <= container.size(); i++)
+		{
+			ids.push_back(container.IDAt(i));
+		}
+		for (const auto& connection : container.GetConnections())
+		{
+			connections.push_back(connection);
+		}
+	}
+
+	bool operator==(const Snapshot& rhs) const
+	{
+		return container == rhs.container && ids == rhs.ids && draw_order == rhs.draw_order && connections == rhs.connections;
+	}
+
+	PostContainer container;
+	std::vector<PostID> ids;
+	std::vector<PostID> draw_order;
+	std::vector<PostContainer::PostConnection> connections;
+};
+
+std::vector<PostID> FillBoard(PostContainer& container, std::size_t count)
+{
+	std::vector<PostID> ids;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		auto it = container.CreatePostBack("Post " + std::to_string(i + 1));
+		it->display_pos = { float(i) * 10.f, float(i) * 20.f };
+		ids.push_back(container.IDOf(it));
+	}
+	return ids;
+}
+
+// What ImGui::InputText does between WatchText and TextChanged
+void Type(EditHistory& history, PostContainer& container, PostID id, const string& text)
+{
+	history.WatchText(container, id, 1);
+	container[id].content[1].AsString() = text;
+	history.TextChanged(container);
+}
+
+SCENARIO("Undoing structural edits gives back the exact board", tag)
+{
+	GIVEN("A board with connections going in and out of one Post")
+	{
+		PostContainer container;
+		EditHistory history;
+		const std::vector<PostID> ids = FillBoard(container, 5);
+		container.Connect(ids[0], ids[1]);
+		container.Connect(ids[1], ids[2]);
+		container.Connect(ids[2], ids[0]);
+		container.Connect(ids[3], ids[1]);
+		container.Connect(ids[4], ids[2]);
+		const Snapshot before(container);
+
+		WHEN("That Post is erased through the history")
+		{
+			history.ErasePost(container, ids[1]);
+			const Snapshot after(container);
+
+			THEN("The Post and its connections are gone, as one undo step")
+			{
+				REQUIRE_FALSE(container.Contains(ids[1]));
+				REQUIRE(container.GetConnections().size() == 2);
+				REQUIRE(history.Undo(container));
+				REQUIRE_FALSE(history.CanUndo());
+			}
+			THEN("Undo restores it with the same PostID, storage position, draw order and connection order")
+			{
+				history.Undo(container);
+				REQUIRE(Snapshot(container) == before);
+
+				AND_THEN("Redo erases it again")
+				{
+					history.Redo(container);
+					REQUIRE(Snapshot(container) == after);
+				}
+			}
+		}
+
+		WHEN("Several edits of every kind are made and then undone")
+		{
+			std::vector<Snapshot> states;
+			states.emplace_back(container);
+
+			history.ErasePost(container, ids[0]);
+			states.emplace_back(container);
+			const PostID created = history.CreatePost(container, Post("New"));
+			states.emplace_back(container);
+			history.Connect(container, created, ids[3]);
+			states.emplace_back(container);
+			history.Disconnect(container, ids[4], ids[2]);
+			states.emplace_back(container);
+			history.ErasePost(container, ids[3]);
+			states.emplace_back(container);
+
+			THEN("Each undo gives back the state before its edit, and each redo the state after it")
+			{
+				for (std::size_t i = states.size() - 1; i > 0; i--)
+				{
+					REQUIRE(history.Undo(container));
+					REQUIRE(Snapshot(container) == states[i - 1]);
+				}
+				REQUIRE_FALSE(history.Undo(container));
+
+				for (std::size_t i = 1; i < states.size(); i++)
+				{
+					REQUIRE(history.Redo(container));
+					REQUIRE(Snapshot(container) == states[i]);
+				}
+				REQUIRE_FALSE(history.Redo(container));
+				REQUIRE(container.Contains(created));
+			}
+		}
+
+		WHEN("A Post reuses an erased Post's slot and both edits are undone")
+		{
+			history.ErasePost(container, ids[4]);
+			const PostID reused = history.CreatePost(container, Post("Reused"));
+			REQUIRE(reused.slot == ids[4].slot);
+			history.Undo(container);
+			history.Undo(container);
+
+			THEN("The slot never hands out the reusing Post's ID again")
+			{
+				REQUIRE(container.Contains(ids[4]));
+				history.ErasePost(container, ids[4]);
+				const PostID created = history.CreatePost(container, Post("Created"));
+				REQUIRE(created.slot == ids[4].slot);
+				REQUIRE_FALSE(created == reused);
+				REQUIRE_FALSE(container.Contains(reused));
+			}
+		}
+
+		WHEN("Many Posts are erased in one group and undone")
+		{
+			PostContainer large;
+			const std::vector<PostID> large_ids = FillBoard(large, 2000);
+			const Snapshot large_before(large);
+			history.BeginGroup();
+			for (const PostID id : large_ids)
+			{
+				history.ErasePost(large, id);
+			}
+			history.EndGroup();
+
+			THEN("Every Post comes back with its PostID")
+			{
+				REQUIRE(large.Empty());
+				REQUIRE(history.Undo(large));
+				REQUIRE(Snapshot(large) == large_before);
+			}
+		}
+
+		WHEN("The draw order changes after an erase")
+		{
+			history.ErasePost(container, ids[2]);
+			container.RaiseToTop(ids[0]);
+			history.Undo(container);
+
+			THEN("The Post comes back above the Post it was above, and IsAbove stays consistent with the draw order")
+			{
+				REQUIRE(container.Below(ids[2]) == ids[1]);
+				const std::vector<PostID> order = container.GetDrawOrder();
+				REQUIRE(order.size() == container.size());
+				for (std::size_t i = 1; i < order.size(); i++)
+				{
+					REQUIRE(container.IsAbove(order[i], order[i - 1]));
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Continuous edits are merged into one step", tag)
+{
+	GIVEN("A board")
+	{
+		PostContainer container;
+		EditHistory history;
+		const std::vector<PostID> ids = FillBoard(container, 2);
+		const auto start = container[ids[0]].display_pos;
+
+		WHEN("A Post is dragged over several frames")
+		{
+			for (int frame = 1; frame <= 30; frame++)
+			{
+				history.MovePost(container, ids[0], { start.first + frame, start.second - frame });
+			}
+
+			THEN("One undo puts it back where the drag started")
+			{
+				history.Undo(container);
+				REQUIRE(container[ids[0]].display_pos == start);
+				REQUIRE_FALSE(history.CanUndo());
+
+				history.Redo(container);
+				REQUIRE(container[ids[0]].display_pos == std::make_pair(start.first + 30, start.second - 30));
+			}
+			AND_WHEN("The drag ends and a new one starts")
+			{
+				history.EndContinuousEdit();
+				history.MovePost(container, ids[0], { 0.f, 0.f });
+
+				THEN("They are undone separately")
+				{
+					history.Undo(container);
+					REQUIRE(container[ids[0]].display_pos == std::make_pair(start.first + 30, start.second - 30));
+					REQUIRE(history.CanUndo());
+				}
+			}
+			AND_WHEN("Another Post is dragged right after")
+			{
+				history.MovePost(container, ids[1], { 0.f, 0.f });
+
+				THEN("Each Post has its own step")
+				{
+					history.Undo(container);
+					REQUIRE(history.Undo(container));
+					REQUIRE(container[ids[0]].display_pos == start);
+				}
+			}
+		}
+
+		WHEN("Text is typed over several frames")
+		{
+			Type(history, container, ids[0], "Post 1!");
+			Type(history, container, ids[0], "Post 1!!");
+			Type(history, container, ids[0], "Pst 1!!");
+
+			THEN("One undo restores the text from before the first change")
+			{
+				history.Undo(container);
+				REQUIRE(container[ids[0]].content[1].AsString() == "Post 1");
+				REQUIRE_FALSE(history.CanUndo());
+
+				history.Redo(container);
+				REQUIRE(container[ids[0]].content[1].AsString() == "Pst 1!!");
+			}
+			THEN("Undo and redo give the content a new revision, so its cached layout is measured again")
+			{
+				const std::uint64_t typed = container[ids[0]].content[1].GetRevision();
+				history.Undo(container);
+				const std::uint64_t undone = container[ids[0]].content[1].GetRevision();
+				history.Redo(container);
+				REQUIRE(undone != typed);
+				REQUIRE(container[ids[0]].content[1].GetRevision() != undone);
+			}
+			AND_WHEN("Editing stops and starts again")
+			{
+				history.EndContinuousEdit();
+				Type(history, container, ids[0], "");
+
+				THEN("Only the second edit is undone first")
+				{
+					history.Undo(container);
+					REQUIRE(container[ids[0]].content[1].AsString() == "Pst 1!!");
+					history.Undo(container);
+					REQUIRE(container[ids[0]].content[1].AsString() == "Post 1");
+				}
+			}
+		}
+
+		WHEN("A text record no longer matches the board")
+		{
+			Type(history, container, ids[0], "Edited");
+			container[ids[0]].content[1].AsString() = "Changed elsewhere";
+
+			THEN("Undo throws and clears the history")
+			{
+				REQUIRE_THROWS_AS(history.Undo(container), utils::EditHistoryError);
+				REQUIRE_FALSE(history.CanUndo());
+				REQUIRE_FALSE(history.CanRedo());
+			}
+		}
+	}
+}
+
+SCENARIO("Groups undo together and can be cancelled", tag)
+{
+	GIVEN("A board")
+	{
+		PostContainer container;
+		EditHistory history;
+		const std::vector<PostID> ids = FillBoard(container, 3);
+		history.Connect(container, ids[0], ids[1]);
+		const Snapshot before(container);
+
+		WHEN("Several edits are made inside a group")
+		{
+			history.BeginGroup();
+			Type(history, container, ids[1], "Grouped");
+			history.SetColor(container, ids[1], { 0.5f, 0.25f, 0.f });
+			history.SetColor(container, ids[1], { 0.f, 0.25f, 0.5f });
+			board::TagEntryList values;
+			values.EmplaceBack(3);
+			history.SetTag(container, ids[1], "priority", values);
+			history.ErasePost(container, ids[0]);
+
+			THEN("Ending the group makes them a single step")
+			{
+				history.EndGroup();
+				history.Undo(container);
+				REQUIRE(Snapshot(container) == before);
+				REQUIRE(history.CanUndo()); // The Connect from before the group
+			}
+			THEN("Cancelling the group undoes them and leaves nothing to redo")
+			{
+				history.CancelGroup(container);
+				REQUIRE(Snapshot(container) == before);
+				REQUIRE_FALSE(history.CanRedo());
+				REQUIRE(history.CanUndo());
+			}
+		}
+
+		WHEN("A new edit is made after an undo")
+		{
+			history.Undo(container);
+			history.CreatePost(container, Post());
+
+			THEN("The undone edit can no longer be redone")
+			{
+				REQUIRE_FALSE(history.CanRedo());
+			}
+		}
+	}
+}
+
+SCENARIO("The history never holds much more memory than its cap", tag)
+{
+	GIVEN("A history with a small memory cap")
+	{
+		PostContainer container;
+		EditHistory history(16 * 1024);
+		const std::vector<PostID> ids = FillBoard(container, 1);
+
+		WHEN("Many large edits are recorded")
+		{
+			for (int i = 0; i < 100; i++)
+			{
+				Type(history, container, ids[0], string(1000, char('a' + i % 26)));
+				history.EndContinuousEdit();
+			}
+
+			THEN("The oldest steps are forgotten and the newest can still be undone")
+			{
+				REQUIRE(history.MemoryUsage() <= history.MemoryCap());
+				REQUIRE(history.MemoryUsage() > 0);
+
+				std::size_t undone = 0;
+				while (history.Undo(container)) undone++;
+				REQUIRE(undone > 0);
+				REQUIRE(undone < 100);
+				REQUIRE(container[ids[0]].content[1].AsString() != "Post 1");
+			}
+			AND_WHEN("The cap is lowered")
+			{
+				history.SetMemoryCap(1);
+
+				THEN("Only the newest step is kept")
+				{
+					REQUIRE(history.Undo(container));
+					REQUIRE_FALSE(history.CanUndo());
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "catch.hpp"
+
+#include "containers/PostContainer.hpp"
+#include "renderables/HeadlessDriver.hpp"
+#include "renderables/tabs/BoardTab.hpp"
+#include "utils/FrameProfiler.hpp"
+
+using std::string;
+
+using board::BoardTab;
+using board::HeadlessDriver;
+using board::PostContainer;
+using utils::FrameProfiler;
+using Phase = utils::FrameProfiler::Phase;
+
+const string tag = "[FrameProfiler]";
+
+SCENARIO("The profiler keeps a rolling history of every phase", tag)
+{
+	GIVEN("An empty history")
+	{
+		FrameProfiler::Clear();
+
+		WHEN("A phase is timed several times in one frame")
+		{
+			FrameProfiler::Add(Phase::Popups, 1.5);
+			FrameProfiler::Add(Phase::Popups, 2.0);
+			FrameProfiler::EndFrame();
+
+			THEN("The frame holds their sum and the other phases are empty")
+			{
+				REQUIRE(FrameProfiler::Frames() == 1);
+				REQUIRE(FrameProfiler::Last(Phase::Popups) == 3.5f);
+				REQUIRE(FrameProfiler::Last(Phase::PostLayout) == 0.f);
+			}
+		}
+
+		WHEN("Frames taking 1 to 100 milliseconds are ended")
+		{
+			for (int ms = 1; ms <= 100; ms++)
+			{
+				FrameProfiler::Add(Phase::Frame, ms);
+				FrameProfiler::EndFrame();
+			}
+
+			THEN("The percentiles are their nearest ranks")
+			{
+				REQUIRE(FrameProfiler::Last(Phase::Frame) == 100.f);
+				REQUIRE(FrameProfiler::Percentile(Phase::Frame, 50.0) == 50.f);
+				REQUIRE(FrameProfiler::Percentile(Phase::Frame, 99.0) == 99.f);
+				REQUIRE(FrameProfiler::Percentile(Phase::Frame, 0.0) == 1.f);
+			}
+		}
+
+		WHEN("More frames than the history holds are ended")
+		{
+			const int count = int(FrameProfiler::history_size) + 60;
+			for (int ms = 1; ms <= count; ms++)
+			{
+				FrameProfiler::Add(Phase::Frame, ms);
+				FrameProfiler::EndFrame();
+			}
+
+			THEN("Only the newest ones are kept")
+			{
+				REQUIRE(FrameProfiler::Frames() == FrameProfiler::history_size);
+				REQUIRE(FrameProfiler::Percentile(Phase::Frame, 0.0) == 61.f);
+				REQUIRE(FrameProfiler::Last(Phase::Frame) == float(count));
+			}
+		}
+
+		WHEN("A timer is stopped early and then destroyed")
+		{
+			{
+				FrameProfiler::Timer timer(Phase::ChannelsMerge);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				timer.Stop();
+				FrameProfiler::EndFrame();
+			}
+			FrameProfiler::EndFrame();
+
+			THEN("Its time was added once, to the frame it was stopped in")
+			{
+				REQUIRE(FrameProfiler::Frames() == 2);
+				REQUIRE(FrameProfiler::Last(Phase::ChannelsMerge) == 0.f);
+				REQUIRE(FrameProfiler::Percentile(Phase::ChannelsMerge, 100.0) >= 1.f);
+			}
+		}
+	}
+}
+
+#ifdef BOARD_PROFILING
+SCENARIO("BoardTab feeds its phases to the profiler", tag)
+{
+	GIVEN("A board rendered by the headless driver")
+	{
+		HeadlessDriver driver;
+		PostContainer container;
+		for (int i = 0; i < 50; i++)
+		{
+			container.CreatePostBack("Post " + std::to_string(i))->display_pos = { float(i % 10) * 120.f, float(i / 10) * 100.f };
+		}
+		BoardTab tab(std::move(container), "board.lua");
+		FrameProfiler::Clear();
+
+		WHEN("A frame is rendered")
+		{
+			driver.RenderFrame(tab);
+			FrameProfiler::EndFrame();
+
+			THEN("The layout and the connections were timed")
+			{
+				REQUIRE(FrameProfiler::Last(Phase::PostLayout) > 0.f);
+				REQUIRE(FrameProfiler::Last(Phase::RenderConnections) > 0.f);
+				REQUIRE(FrameProfiler::Last(Phase::PopulateCurrentFrameInfo) > 0.f);
+			}
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include <cstdio> // std::remove
+#include <string>
+
+#include "catch.hpp"
+
+#include "utils/parsing/LuaBoardReader.hpp"
+#include "utils/parsing/BoardParser.hpp"
+#include "containers/PostContainer.hpp"
+#include "utils/LuaStack.hpp"
+
+using utils::LuaBoardReader;
+using utils::BoardParser;
+using utils::LuaStack;
+using utils::ScriptParser;
+using board::PostContainer;
+using std::string;
+
+const string tag = "[LuaBoardReader]";
+
+// Testing helpers
+PostContainer ParseWithLua(const string& board)
+{
+	return BoardParser().Parse(LuaStack::DeserializeTableString(board));
+}
+
+SCENARIO("LuaBoardReader reads boards the same way the Lua state does", tag)
+{
+	GIVEN("The boards used by the BoardParser tests")
+	{
+		LuaStack::Init();
+
+		const string tagged_board = R"({posts =
+{
+  {
+    color = {
+      150,
+      150,
+      150
+    },
+    content = {
+      "Nothing at all.",
+      "Testing content."
+    },
+    display_pos = {
+      50,
+      50
+    },
+    tags = {
+      falsehood = {
+        true
+      },
+      maybe = {
+        false,
+        true
+      },
+      next = {
+        2
+      },
+      random = {
+        5,
+        7,
+        8,
+      },
+      truth = {
+        false
+      }
+    }
+  },
+  {
+    content = {
+      "Getting your bearings."
+    },
+    display_pos = {
+      150,
+      150
+    }
+  },
+  {
+    content = {
+      "Playing around with testing."
+    },
+    display_pos = {
+      311,
+      295
+    },
+    tags = {
+      on_top = {
+        true
+      },
+      sometext = {
+        "Random text."
+      }
+    }
+  },
+  {
+    content = {
+      "Getting your bearings."
+    },
+    display_pos = {
+      250,
+      250
+    }
+  }
+},
+board_config = {bg_color = {30, 30, 30}}
+})";
+
+		const string connected_board = R"({
+  board_config = {
+    bg_color = {
+      119,
+      119,
+      119
+    },
+    connection_color = {
+      255,
+      255,
+      255
+    },
+    post_color = {
+      35,
+      53,
+      114
+    },
+    selected_connection_color = {
+      15,
+      15,
+      15
+    },
+    text_color = {
+      223,
+      187,
+      187
+    }
+  },
+  connections = {
+    {
+      1,
+      2
+    },
+    {
+      2,
+      3
+    }
+  },
+  posts = {
+    {
+      content = {
+        "Testing serialization and deserialization.\n\nThis post has 1 connection."
+      },
+      display_pos = {
+        325,
+        251
+      }
+    },
+    {
+      color = {
+        127,
+        20,
+        20
+      },
+      content = {
+        "This post is red."
+      },
+      display_pos = {
+        742,
+        373
+      }
+    },
+    {
+      color = {
+        114,
+        40,
+        204
+      },
+      content = {
+        "But this one is purple."
+      },
+      display_pos = {
+        863,
+        285
+      }
+    },
+    {
+      content = {
+        "This post has no connections at all."
+      },
+      display_pos = {
+        290,
+        413
+      }
+    }
+  }
+})";
+
+		WHEN("They are parsed by LuaBoardReader")
+		{
+			const PostContainer tagged = LuaBoardReader::Parse(tagged_board);
+			const PostContainer connected = LuaBoardReader::Parse(connected_board);
+
+			THEN("The result is equal to the one built through the Lua state")
+			{
+				REQUIRE(tagged == ParseWithLua(tagged_board));
+				REQUIRE(connected == ParseWithLua(connected_board));
+				REQUIRE(connected[1].content[1] == "Testing serialization and deserialization.\n\nThis post has 1 connection.");
+				REQUIRE(connected.IsConnected(connected.IDAt(2), connected.IDAt(3)));
+			}
+		}
+
+		WHEN("A board saved by BoardParser is read back from disk")
+		{
+			const string path = "lua_board_reader_test.lua";
+			BoardParser parser;
+			const PostContainer original = ParseWithLua(connected_board);
+			parser.SavePath(original, path);
+
+			const PostContainer native = parser.LoadPath(path);
+			const PostContainer through_lua = parser.ParsePath(path);
+			std::remove(path.c_str());
+
+			THEN("Both readers agree with the original")
+			{
+				REQUIRE(native == through_lua);
+				REQUIRE(native == original);
+			}
+		}
+	}
+}
+
+SCENARIO("LuaBoardReader understands the rest of the table literal syntax", tag)
+{
+	GIVEN("A board using escapes, long strings, comments, bracketed keys and numbers of every kind")
+	{
+		LuaStack::Init();
+
+		const string board = R"(return {
+  -- A line comment
+  posts = {
+    { content = "Quote \"inside\", tab\tand \65\066\x43 \u{48}\u{e9}\z
+                 skipped", display_pos = { 2.5, -1e2 }, tags = { ["with space"] = { 1, -3, 0x10, 'single' }, lonely = true } },
+    --[==[ A long
+    comment ]==]
+    { content = { [[
+Long string with "quotes" and ]] .. ']]' } }
+  };
+  unknown = { nested = { 1, { 2 } }, flag = false },
+  ["board_config"] = { text_color = { 1, 2, 3 }; },
+  connections = { { 2, 1 } },
+};)";
+
+		WHEN("It is parsed by LuaBoardReader")
+		{
+			THEN("Unsupported expressions such as concatenation are reported")
+			{
+				REQUIRE_THROWS_AS(LuaBoardReader::Parse(board), utils::ParsingError);
+			}
+		}
+
+		WHEN("The concatenation is removed")
+		{
+			string valid = board;
+			valid.replace(valid.find(" .. ']]'"), 8, "");
+
+			const PostContainer native = LuaBoardReader::Parse(valid);
+
+			THEN("The result is equal to the one built through the Lua state")
+			{
+				REQUIRE(native == ParseWithLua(valid.substr(string("return ").size())));
+				REQUIRE(native[1].content[1] == "Quote \"inside\", tab\tand ABC H\xc3\xa9skipped");
+				REQUIRE(native[2].content[1] == "Long string with \"quotes\" and ");
+				REQUIRE(native[1].display_pos == std::pair<float, float>(2.5f, -100.f));
+				REQUIRE(native[1].tags["with space"][3] == 16);
+				REQUIRE(native.IsConnected(native.IDAt(2), native.IDAt(1)));
+			}
+		}
+	}
+}
+
+SCENARIO("LuaBoardReader keeps integer and float Tags apart", tag)
+{
+	GIVEN("A board with integer and float Tag values")
+	{
+		const string board = "{ posts = { { content = 'a', tags = { numbers = { 2, 2.5, 1e2, -0x10, 3.0 } } } } }";
+
+		WHEN("It is parsed by LuaBoardReader")
+		{
+			const PostContainer native = LuaBoardReader::Parse(board);
+			const auto& numbers = native[1].tags["numbers"];
+
+			THEN("Only Lua integers become integer Tags")
+			{
+				REQUIRE(numbers[1].isInt());
+				REQUIRE(numbers[2].isFloat());
+				REQUIRE(numbers[2] == 2.5f);
+				REQUIRE(numbers[3].isFloat());
+				REQUIRE(numbers[4] == -16);
+				REQUIRE(numbers[5].isFloat());
+			}
+		}
+	}
+}
+
+SCENARIO("LuaBoardReader reports where an invalid board goes wrong", tag)
+{
+	GIVEN("Boards with syntax and content errors")
+	{
+		const string missing_brace = "{\n  posts = {\n    { content = \"a\" \n  }\n";
+		const string unfinished_string = "{\n  posts = { { content = \"abc } }\n}";
+		const string bad_escape = "{ posts = { { content = \"\\q\" } } }";
+		const string no_content = "{\n  posts = {\n    { display_pos = { 1, 2 } }\n  }\n}";
+		const string no_posts = "{ posts__ = {} }";
+		const string bad_connection = "{\n  posts = { { content = \"a\" } },\n  connections = {\n    { 1, 2 }\n  }\n}";
+		const string bad_color = "{ posts = { { content = \"a\", color = { 1, 2 } } } }";
+		const string trailing = "{ posts = {} } }";
+
+		THEN("The errors carry the line and column of the problem")
+		{
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(missing_brace), "Line 5, column 1: Expected '}' or a field separator but the file ended.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(unfinished_string), "Line 2, column 25: Unfinished string.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(bad_escape), "Line 1, column 27: Invalid escape sequence.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(no_content), "Line 3, column 5: Post has no valid 'content' field.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(no_posts), "Line 1, column 1: The file does not have a Posts table.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(bad_connection), "Line 4, column 5: Connection refers to a Post that does not exist.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(bad_color), "Line 1, column 38: Post color is not valid.");
+			REQUIRE_THROWS_WITH(LuaBoardReader::Parse(trailing), "Line 1, column 16: Expected the end of the file.");
+		}
+	}
+}
\ No newline at end of file
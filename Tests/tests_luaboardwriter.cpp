@@ -0,0 +1,158 @@
+#include <cstdio> // std::remove
+#include <fstream>
+#include <string>
+
+#include "catch.hpp"
+
+#include "utils/parsing/LuaBoardWriter.hpp"
+#include "utils/parsing/LuaBoardReader.hpp"
+#include "utils/parsing/BoardParser.hpp"
+#include "containers/PostContainer.hpp"
+#include "utils/LuaStack.hpp"
+
+using utils::LuaBoardWriter;
+using utils::LuaBoardReader;
+using utils::BoardParser;
+using utils::LuaStack;
+using utils::LuaValue;
+using board::PostContainer;
+using std::string;
+
+const string tag = "[LuaBoardWriter]";
+
+// Testing helpers
+PostContainer WriterSampleContainer()
+{
+	PostContainer container;
+	auto first = container.CreatePostBack("Quote \", backslash \\, line\nbreak, tab\t, \r1 and \x7f.");
+	first->display_pos = { 0.1f, -1e10f };
+	first->content.EmplaceBack("Unicode: \xc3\xa9\xe6\xbc\xa2");
+	first->tags["numbers"].EmplaceBack(-7);
+	first->tags["numbers"].EmplaceBack(3.75f);
+	first->tags["end"].EmplaceBack(true);
+	first->tags["with space"].EmplaceBack(false);
+	first->tags["n10"].EmplaceBack(LuaValue::Variant(string("ten")));
+	first->tags["n9"].EmplaceBack(LuaValue::Variant(string("nine")));
+	first->tags["n09a"].EmplaceBack(LuaValue::Variant(string("")));
+	first->tags["_under"].EmplaceBack(1);
+
+	auto second = container.CreatePostBack("Second post.");
+	second->color[0] = 0.5f;
+	second->color[1] = 0.25f;
+	second->color[2] = 1.f;
+
+	container.CreatePostBack("");
+	container.board_options.color_table.bg[0] = 0.123f;
+
+	container.Connect(container.IDAt(1), container.IDAt(2));
+	container.Connect(container.IDAt(3), container.IDAt(1));
+	container.RaiseToTop(container.IDAt(1));
+	return container;
+}
+
+string SerpentString(const PostContainer& container, bool compact)
+{
+	const sol::table table = BoardParser().ToTable(container);
+	if (!compact) return LuaStack::TableToString(table);
+
+	sol::table options = LuaStack::EmptyTable();
+	options["comment"] = false;
+	options["compact"] = true;
+	sol::function line = LuaStack::GetGlobalTable("serpent")["line"];
+	return line(table, options);
+}
+
+SCENARIO("LuaBoardWriter writes the same text as serpent", tag)
+{
+	GIVEN("A PostContainer with escapes, floats, tags, colors and connections")
+	{
+		LuaStack::Init();
+		const PostContainer container = WriterSampleContainer();
+
+		WHEN("It is written in both styles")
+		{
+			const string pretty = LuaBoardWriter::ToString(container);
+			const string compact = LuaBoardWriter::ToString(container, LuaBoardWriter::Style::compact);
+
+			THEN("The output matches serpent byte for byte")
+			{
+				REQUIRE(pretty == SerpentString(container, false));
+				REQUIRE(compact == SerpentString(container, true));
+				REQUIRE(compact.find('\n') == string::npos);
+			}
+
+			THEN("Reading either style back gives the same board")
+			{
+				// Colors are stored as integers, so the text is compared instead of the containers
+				const PostContainer from_pretty = LuaBoardReader::Parse(pretty);
+				REQUIRE(LuaBoardWriter::ToString(from_pretty) == pretty);
+				REQUIRE(LuaBoardReader::Parse(compact) == from_pretty);
+				REQUIRE(from_pretty[3].content[1] == container[container.IDAt(1)].content[1]);
+			}
+		}
+
+		WHEN("An empty container is written")
+		{
+			const PostContainer empty;
+
+			THEN("The output still matches serpent")
+			{
+				REQUIRE(LuaBoardWriter::ToString(empty) == SerpentString(empty, false));
+				REQUIRE(LuaBoardWriter::ToString(empty, LuaBoardWriter::Style::compact) == SerpentString(empty, true));
+			}
+		}
+	}
+}
+
+SCENARIO("LuaBoardWriter saves boards through BoardParser", tag)
+{
+	GIVEN("A PostContainer and a Lua board path")
+	{
+		LuaStack::Init();
+		const PostContainer container = WriterSampleContainer();
+		const string path = "lua_board_writer_test.lua";
+
+		WHEN("It is saved and opened again")
+		{
+			BoardParser parser;
+			parser.SavePath(container, path);
+			const string saved = LuaStack::StringFromFile(path);
+			const PostContainer parsed = parser.LoadPath(path);
+			std::remove(path.c_str());
+
+			THEN("The file holds the pretty output and reads back to the same text")
+			{
+				REQUIRE(saved == LuaBoardWriter::ToString(container));
+				REQUIRE(LuaBoardWriter::ToString(parsed) == saved);
+			}
+		}
+	}
+
+	GIVEN("A PostContainer with content the Lua format cannot store")
+	{
+		PostContainer container;
+		auto post = container.CreatePostBack("Text.");
+		post->content.EmplaceBack("images/cat.png", "A cat.");
+
+		THEN("Writing it throws like ParsingStrategies::ContainerToTable")
+		{
+			REQUIRE_THROWS_AS(LuaBoardWriter::ToString(container), utils::SerializingError);
+		}
+
+		WHEN("It is saved over an existing board")
+		{
+			const string path = "lua_board_writer_failed_save_test.lua";
+			const PostContainer existing = WriterSampleContainer();
+			LuaBoardWriter::ToFile(existing, path);
+
+			THEN("Saving throws and leaves the existing file as it was")
+			{
+				REQUIRE_THROWS_AS(LuaBoardWriter::ToFile(container, path), utils::SerializingError);
+				const string saved = LuaStack::StringFromFile(path);
+				std::remove(path.c_str());
+				REQUIRE(saved == LuaBoardWriter::ToString(existing));
+				REQUIRE_FALSE(std::ifstream(path + ".tmp"));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -389,4 +389,102 @@ SCENARIO("two LuaVectors holding the same type can be compared", tag)
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+SCENARIO("The access policy decides what happens past the end", tag)
+{
+	GIVEN("LuaVectors of ints holding 3 elements")
+	{
+		const vector<int> three{ 1, 2, 3 };
+		LuaVector<int, LuaVectorAccess::checked> checked = three;
+		LuaVector<int, LuaVectorAccess::growing> growing = three;
+		LuaVector<int, LuaVectorAccess::unchecked> unchecked = three;
+
+		THEN("Every policy reads and writes valid indexes the same way")
+		{
+			checked[2] = 20;
+			growing[2] = 20;
+			unchecked[2] = 20;
+			REQUIRE(checked[2] == 20);
+			REQUIRE(growing[2] == 20);
+			REQUIRE(unchecked[2] == 20);
+		}
+		WHEN("An index past the end is accessed")
+		{
+			THEN("A checked LuaVector throws and keeps its size")
+			{
+				REQUIRE_THROWS_WITH(checked[4], "LuaVector does not have index 4.");
+				REQUIRE(checked.size() == 3);
+			}
+			THEN("A growing LuaVector grows to it")
+			{
+				growing[6] = 6;
+				REQUIRE(growing.size() == 6);
+				REQUIRE(growing[5] == 0);
+				REQUIRE(growing[6] == 6);
+			}
+		}
+		WHEN("Index 0 is accessed")
+		{
+			THEN("Neither the checked nor the growing LuaVector accept it")
+			{
+				REQUIRE_THROWS_WITH(checked[0], "LuaVector does not have index 0.");
+				REQUIRE_THROWS_WITH(growing[0], "LuaVector does not have index 0.");
+				REQUIRE(growing.size() == 3);
+			}
+		}
+		WHEN("A const reference to the growing LuaVector is made")
+		{
+			const auto& const_growing = growing;
+
+			THEN("It does not grow")
+			{
+				REQUIRE_THROWS_WITH(const_growing[4], "LuaVector does not have index 4.");
+			}
+		}
+	}
+}
+
+SCENARIO("LuaVector can hold bools", tag)
+{
+	GIVEN("A LuaVector of bools")
+	{
+		LuaVector<bool> v(true);
+		v[3] = true;
+
+		THEN("It grows like any other LuaVector and hands out references to its elements")
+		{
+			REQUIRE(v.size() == 3);
+			REQUIRE_FALSE(v[1]);
+			REQUIRE(v[3]);
+
+			bool& second = v[2];
+			second = true;
+			REQUIRE(v[2]);
+		}
+		WHEN("It is built from and compared to a std::vector of bools")
+		{
+			const vector<bool> flags{ true, false, true };
+			const LuaVector<bool> from_flags = flags;
+
+			THEN("The elements match")
+			{
+				REQUIRE(CompareLuaVectorToVector(from_flags, flags));
+				REQUIRE(from_flags == LuaVector<bool>(flags));
+				REQUIRE_FALSE(from_flags == v);
+			}
+		}
+		WHEN("It is iterated and modified")
+		{
+			v.PushBack(false);
+			v.Insert(v.begin(), true);
+			v.ChangeAllValues(true);
+
+			THEN("Every element was set")
+			{
+				REQUIRE(v.size() == 5);
+				for (bool value : v) REQUIRE(value);
+			}
+		}
+	}
+}
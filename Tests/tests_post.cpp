@@ -13,6 +13,7 @@ using std::string;
 
 using board::Post;
 using board::PostContainer;
+using board::PostID;
 
 using utils::BoardParser;
 using utils::LuaStack;
@@ -20,11 +21,11 @@ using utils::LuaStack;
 const string tag = "[Post]";
 const string tag2 = "[PostContainer]";
 
-auto AreIndexesValid = [](PostContainer& c) -> bool
+auto AreIDsValid = [](PostContainer& c) -> bool
 {
 	for (std::size_t i = 1; i <= c.size(); i++)
 	{
-		if (c[i].GetIdx() != i) return false;
+		if (c.PositionOf(c.IDAt(i)) != i) return false;
 	}
 	return true;
 };
@@ -74,6 +75,42 @@ SCENARIO("Post.HasColor() reports correctly", tag)
 	}
 }
 
+SCENARIO("PostContent revisions change with every edit", tag)
+{
+	GIVEN("Two contents with the same text")
+	{
+		board::PostContent first("Text");
+		board::PostContent second("Text");
+
+		THEN("They compare equal but were given different revisions")
+		{
+			REQUIRE(first == second);
+			REQUIRE(first.GetRevision() != second.GetRevision());
+		}
+
+		WHEN("One is copied")
+		{
+			const board::PostContent copy = first;
+
+			THEN("The copy keeps the revision, as it holds the same text")
+			{
+				REQUIRE(copy.GetRevision() == first.GetRevision());
+			}
+			AND_WHEN("The original is edited")
+			{
+				first.AsString() += "!";
+				first.Edited();
+
+				THEN("Only the original has a new revision")
+				{
+					REQUIRE(first.GetRevision() != copy.GetRevision());
+					REQUIRE(copy == second);
+				}
+			}
+		}
+	}
+}
+
 SCENARIO("Overload resolution regarding CreatePost/Back and Insert and their r-value overloads is correct", tag2)
 {
 	GIVEN("A default constructed PostContainer")
@@ -188,7 +225,7 @@ SCENARIO("Creating Post in-place works", tag2)
 	}
 }
 
-SCENARIO("Erasing posts updates container's contents indexes", tag2)
+SCENARIO("Erasing posts leaves the IDs of the remaining posts untouched", tag2)
 {
 	GIVEN("A PostContainer with some posts, some of which have links")
 	{
@@ -282,45 +319,59 @@ SCENARIO("Erasing posts updates container's contents indexes", tag2)
 		LuaStack::Init();
 		PostContainer container = BoardParser().Parse(LuaStack::DeserializeTableString(sample_board));
 
-		WHEN("Indexes are changed because of a removal")
+		const PostID id1 = container.IDAt(1);
+		const PostID id2 = container.IDAt(2);
+		const PostID id3 = container.IDAt(3);
+		const PostID id4 = container.IDAt(4);
+
+		WHEN("A post without connections is removed")
 		{
-			REQUIRE(AreIndexesValid(container));
+			REQUIRE(AreIDsValid(container));
 
 			container.Erase(container.IteratorFromIndex(3));
 
-			REQUIRE(AreIndexesValid(container));
+			REQUIRE(AreIDsValid(container));
+
+			THEN("The erased ID is no longer valid, every other ID still refers to the same post")
+			{
+				REQUIRE_FALSE(container.Contains(id3));
+				REQUIRE(container.Contains(id1));
+				REQUIRE(container.Contains(id2));
+				REQUIRE(container.Contains(id4));
 
-			THEN("Posts stay connected, and the ID they hold of connected post is updated")
+				REQUIRE(container[id4].content[1] == "This post has a connection, as a treat.");
+			}
+			THEN("Posts stay connected and their connections are not rewritten")
 			{
-				auto& connections = container.connections;
+				auto& connections = container.GetConnections();
 				REQUIRE(connections.size() == 2);
 
 				auto& connection_1 = connections[1];
 				auto& connection_2 = connections[2];
 
-				REQUIRE(connection_1.from == 1);
-				REQUIRE(connection_1.to == 2);
+				REQUIRE(connection_1.from == id1);
+				REQUIRE(connection_1.to == id2);
 
-				REQUIRE(connection_2.from == 2);
-				REQUIRE(connection_2.to == 3);
+				REQUIRE(connection_2.from == id2);
+				REQUIRE(connection_2.to == id4);
 			}
 		}
 		WHEN("A post that is connected to another is removed")
 		{
 			REQUIRE(container.size() == 4);
-			REQUIRE(container.connections.size() == 2);
+			REQUIRE(container.GetConnections().size() == 2);
 			container.Erase(container.IteratorFromIndex(4));
 			REQUIRE(container.size() == 3);
-			REQUIRE(AreIndexesValid(container));
+			REQUIRE(AreIDsValid(container));
 
 			THEN("Connections to the erased post are deleted")
 			{
-				auto& connections = container.connections;
+				auto& connections = container.GetConnections();
 				REQUIRE(connections.size() == 1);
 				auto& connection_1 = connections[1];
 
-				REQUIRE(connection_1.from == 1);
-				REQUIRE(connection_1.to == 2);
+				REQUIRE(connection_1.from == id1);
+				REQUIRE(connection_1.to == id2);
 			}
 
 			
@@ -328,7 +379,7 @@ SCENARIO("Erasing posts updates container's contents indexes", tag2)
 	}
 }
 
-SCENARIO("Calling MoveToLastPosition correctly adjusts indexes", tag2)
+SCENARIO("Calling MoveToLastPosition keeps IDs and connections intact", tag2)
 {
 	GIVEN("A PostContainer populated with nodes that hold connections")
 	{
@@ -422,9 +473,14 @@ SCENARIO("Calling MoveToLastPosition correctly adjusts indexes", tag2)
 		LuaStack::Init();
 		PostContainer container = BoardParser().Parse(LuaStack::DeserializeTableString(sample_board));
 
-		REQUIRE(AreIndexesValid(container));
+		REQUIRE(AreIDsValid(container));
 		REQUIRE(container.size() == 4);
-		REQUIRE(container.connections.size() == 2);
+		REQUIRE(container.GetConnections().size() == 2);
+
+		const PostID id1 = container.IDAt(1);
+		const PostID id2 = container.IDAt(2);
+		const PostID id3 = container.IDAt(3);
+		const PostID id4 = container.IDAt(4);
 
 		WHEN("MoveToLastPosition is called on a Post")
 		{
@@ -432,24 +488,302 @@ SCENARIO("Calling MoveToLastPosition correctly adjusts indexes", tag2)
 			REQUIRE(container.size() == 4);
 			REQUIRE(container[4].content[1].AsString() == "This post is red.");
 
-			THEN("Posts that succeeded the move subject have their indexes decreased by 1")
+			THEN("Posts that succeeded the move subject are shifted back by 1 position")
 			{
-				REQUIRE(AreIndexesValid(container));
+				REQUIRE(AreIDsValid(container));
+				REQUIRE(container.PositionOf(id1) == 1);
+				REQUIRE(container.PositionOf(id3) == 2);
+				REQUIRE(container.PositionOf(id4) == 3);
+				REQUIRE(container.PositionOf(id2) == 4);
 			}
-			THEN("Connections to move subject are updated to reflect new indexes")
+			THEN("Connections to move subject still refer to it")
 			{
-				auto& connections = container.connections;
+				auto& connections = container.GetConnections();
 
 				REQUIRE(connections.size() == 2);
 
 				auto& connection_1 = connections[1];
 				auto& connection_2 = connections[2];
 
-				REQUIRE(connection_1.from == 1);
-				REQUIRE(connection_1.to == 4);
-				REQUIRE(connection_2.from == 4);
-				REQUIRE(connection_2.to == 2);
+				REQUIRE(connection_1.from == id1);
+				REQUIRE(connection_1.to == id2);
+				REQUIRE(connection_2.from == id2);
+				REQUIRE(connection_2.to == id3);
+
+			}
+		}
+	}
+}
+
+SCENARIO("A PostID never resolves to a post other than the one it was given to", tag2)
+{
+	GIVEN("A PostContainer with a few posts")
+	{
+		PostContainer container;
+		container.CreatePostBack("First");
+		container.CreatePostBack("Second");
+		container.CreatePostBack("Third");
+
+		const PostID second = container.IDAt(2);
+		const PostID third = container.IDAt(3);
+
+		REQUIRE_FALSE(container.Contains(PostID()));
+		REQUIRE(container[second].content[1] == "Second");
+
+		WHEN("A post is erased and a new one is created in its place")
+		{
+			container.Erase(container.IteratorFromID(second));
+			container.CreatePostBack("Fourth");
+			const PostID fourth = container.IDAt(3);
+
+			THEN("The ID of the erased post is stale, even if its slot was reused")
+			{
+				REQUIRE_FALSE(container.Contains(second));
+				REQUIRE(container.PositionOf(second) == 0);
+				REQUIRE_FALSE(second == fourth);
+				REQUIRE_THROWS_AS(container.IteratorFromID(second), utils::PostContainerError);
+
+				REQUIRE(container[fourth].content[1] == "Fourth");
+				REQUIRE(container[third].content[1] == "Third");
+				REQUIRE(AreIDsValid(container));
+			}
+		}
+		WHEN("A post is inserted before the others")
+		{
+			container.CreatePost(container.begin(), "Zeroth");
+
+			THEN("Existing IDs are kept and their positions move forward")
+			{
+				REQUIRE(container.PositionOf(second) == 3);
+				REQUIRE(container.PositionOf(third) == 4);
+				REQUIRE(container[1].content[1] == "Zeroth");
+				REQUIRE(AreIDsValid(container));
+			}
+		}
+	}
+}
+
+SCENARIO("Connections are indexed per post and cannot be duplicated", tag2)
+{
+	GIVEN("A PostContainer with three posts")
+	{
+		PostContainer container;
+		container.CreatePostBack("A");
+		container.CreatePostBack("B");
+		container.CreatePostBack("C");
+
+		const PostID a = container.IDAt(1);
+		const PostID b = container.IDAt(2);
+		const PostID c = container.IDAt(3);
+
+		WHEN("Connections are created")
+		{
+			REQUIRE(container.Connect(a, b));
+			REQUIRE(container.Connect(a, c));
+			REQUIRE(container.Connect(c, b));
+
+			THEN("Repeated connections and connections to self are refused")
+			{
+				REQUIRE_FALSE(container.Connect(a, b));
+				REQUIRE_FALSE(container.Connect(b, b));
+				REQUIRE(container.GetConnections().size() == 3);
+				REQUIRE_THROWS_AS(container.Connect(a, PostID()), utils::PostContainerError);
+			}
+			THEN("Each post knows its outgoing and incoming connections")
+			{
+				REQUIRE(container.Outgoing(a).size() == 2);
+				REQUIRE(container.Incoming(a).empty());
+				REQUIRE(container.Incoming(b).size() == 2);
+				REQUIRE(container.Outgoing(c).size() == 1);
+				REQUIRE(container.Outgoing(c)[0] == b);
+				REQUIRE(container.IsConnected(c, b));
+				REQUIRE_FALSE(container.IsConnected(b, c));
+			}
+			AND_WHEN("A connection is removed")
+			{
+				REQUIRE(container.Disconnect(a, b));
+				REQUIRE_FALSE(container.Disconnect(a, b));
+
+				THEN("Only that connection is gone")
+				{
+					REQUIRE(container.GetConnections().size() == 2);
+					REQUIRE_FALSE(container.IsConnected(a, b));
+					REQUIRE(container.IsConnected(a, c));
+					REQUIRE(container.IsConnected(c, b));
+					REQUIRE(container.Outgoing(a).size() == 1);
+					REQUIRE(container.Incoming(b).size() == 1);
+				}
+			}
+			AND_WHEN("A post is erased")
+			{
+				container.Erase(container.IteratorFromID(c));
+
+				THEN("Its connections are removed from both ends")
+				{
+					REQUIRE(container.GetConnections().size() == 1);
+					REQUIRE(container.IsConnected(a, b));
+					REQUIRE(container.Outgoing(a).size() == 1);
+					REQUIRE(container.Incoming(b).size() == 1);
+				}
+				AND_WHEN("A new post takes its slot")
+				{
+					container.CreatePostBack("D");
+					const PostID d = container.IDAt(3);
+
+					THEN("The new post starts without connections")
+					{
+						REQUIRE(container.Outgoing(d).empty());
+						REQUIRE(container.Incoming(d).empty());
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Raising a post to the top only changes the draw order", tag2)
+{
+	GIVEN("A PostContainer with three posts")
+	{
+		PostContainer container;
+		container.CreatePostBack("A");
+		container.CreatePostBack("B");
+		container.CreatePostBack("C");
+
+		const PostID a = container.IDAt(1);
+		const PostID b = container.IDAt(2);
+		const PostID c = container.IDAt(3);
+
+		THEN("Posts are drawn in the order they were created")
+		{
+			REQUIRE(container.GetDrawOrder() == std::vector<PostID>{ a, b, c });
+			REQUIRE(container.Bottom() == a);
+			REQUIRE(container.Top() == c);
+			REQUIRE(container.Above(c).IsNull());
+		}
+		WHEN("RaiseToTop is called on a post")
+		{
+			container.RaiseToTop(a);
+
+			THEN("It is drawn last while its position in the container is kept")
+			{
+				REQUIRE(container.GetDrawOrder() == std::vector<PostID>{ b, c, a });
+				REQUIRE(container.PositionOf(a) == 1);
+				REQUIRE(container.IsAbove(a, c));
+				REQUIRE_FALSE(container.IsAbove(b, a));
+				REQUIRE(container[1].content[1] == "A");
+			}
+			AND_WHEN("A post in the middle of the draw order is erased")
+			{
+				container.Erase(container.IteratorFromID(c));
+
+				THEN("The draw order skips over it")
+				{
+					REQUIRE(container.GetDrawOrder() == std::vector<PostID>{ b, a });
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("A Batch of edits has the same result as applying them one by one", tag2)
+{
+	GIVEN("Two identical PostContainers with connected posts")
+	{
+		PostContainer one_by_one;
+		PostContainer batched;
+		for (PostContainer* container : { &one_by_one, &batched })
+		{
+			container->CreatePostBack("A");
+			container->CreatePostBack("B");
+			container->CreatePostBack("C");
+			container->Connect(container->IDAt(1), container->IDAt(2));
+			container->Connect(container->IDAt(2), container->IDAt(3));
+		}
+		REQUIRE(one_by_one == batched);
+
+		WHEN("The same edits are applied one by one to a container and through a Batch to the other")
+		{
+			{
+				const PostID a = one_by_one.IDAt(1);
+				const PostID c = one_by_one.IDAt(3);
+				one_by_one.Erase(one_by_one.IteratorFromIndex(2));
+				PostID d = one_by_one.IDOf(one_by_one.CreatePostBack("D"));
+				PostID e = one_by_one.IDOf(one_by_one.CreatePostBack("E"));
+				one_by_one.Connect(d, e);
+				one_by_one.Connect(a, d);
+				one_by_one.RaiseToTop(a);
+				one_by_one.Disconnect(a, d);
+				one_by_one.Connect(e, c);
+			}
+
+			PostContainer::Batch batch(batched);
+			const PostID a = batched.IDAt(1);
+			const PostID c = batched.IDAt(3);
+			batch.Erase(batched.IDAt(2));
+			PostID d = batch.InsertBack(Post("D"));
+			PostID e = batch.InsertBack(Post("E"));
+			batch.Connect(d, e);
+			batch.Connect(a, d);
+			batch.RaiseToTop(a);
+			batch.Disconnect(a, d);
+			batch.Connect(e, c);
+
+			THEN("Nothing changes before Commit is called")
+			{
+				REQUIRE(batch.size() == 8);
+				REQUIRE(batched.size() == 3);
+				REQUIRE_FALSE(batched.Contains(d));
+			}
+			AND_WHEN("The Batch is committed")
+			{
+				batch.Commit();
+
+				THEN("Both containers end up the same")
+				{
+					REQUIRE(batch.Empty());
+					REQUIRE(one_by_one == batched);
+					REQUIRE(batched[d].content[1] == "D");
+					REQUIRE(batched.IsConnected(e, c));
+					REQUIRE_FALSE(batched.IsConnected(a, d));
+
+					auto positions = [](const PostContainer& container)
+					{
+						std::vector<std::size_t> result;
+						for (PostID id : container.GetDrawOrder()) result.push_back(container.PositionOf(id));
+						return result;
+					};
+					REQUIRE(positions(one_by_one) == positions(batched));
+				}
+			}
+			AND_WHEN("The Batch is rolled back")
+			{
+				batch.Rollback();
+				batch.Commit();
 
+				THEN("The container is untouched and the queued PostIDs are stale")
+				{
+					REQUIRE(batched.size() == 3);
+					REQUIRE(batched.GetConnections().size() == 2);
+					REQUIRE_FALSE(batched.Contains(d));
+					REQUIRE_FALSE(batched.Contains(e));
+				}
+			}
+		}
+		WHEN("A Batch refers to a post that it already erased")
+		{
+			PostContainer::Batch batch(batched);
+			const PostID a = batched.IDAt(1);
+			PostID d = batch.InsertBack(Post("D"));
+			batch.Erase(a);
+			batch.Connect(d, a);
+
+			THEN("Commit throws and no edit is applied")
+			{
+				REQUIRE_THROWS_AS(batch.Commit(), utils::PostContainerError);
+				REQUIRE(batched == one_by_one);
+				REQUIRE(batched.Contains(a));
+				REQUIRE_FALSE(batched.Contains(d));
 			}
 		}
 	}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "containers/SpatialGrid.hpp"
+
+using board::SpatialGrid;
+using board::PostID;
+using std::string;
+using std::vector;
+
+const string tag = "[SpatialGrid]";
+
+// Testing helpers
+vector<PostID> Sorted(vector<PostID> ids)
+{
+	std::sort(ids.begin(), ids.end(), [](const PostID& lhs, const PostID& rhs) { return lhs.slot < rhs.slot; });
+	return ids;
+}
+
+SCENARIO("Point queries only report rectangles that contain the point", tag)
+{
+	GIVEN("A grid with overlapping rectangles, one of them spanning several cells")
+	{
+		SpatialGrid grid(100.f);
+		const PostID small{ 0, 1 };
+		const PostID wide{ 1, 1 };
+		const PostID far_away{ 2, 1 };
+
+		grid.Update(small, ImRect(10.f, 10.f, 50.f, 50.f));
+		grid.Update(wide, ImRect(20.f, 20.f, 420.f, 60.f));
+		grid.Update(far_away, ImRect(-5000.f, -5000.f, -4900.f, -4900.f));
+
+		REQUIRE(grid.size() == 3);
+
+		WHEN("A point inside both overlapping rectangles is queried")
+		{
+			vector<PostID> result;
+			grid.QueryPoint(ImVec2(30.f, 30.f), result);
+
+			THEN("Both are reported")
+			{
+				REQUIRE(Sorted(result) == vector<PostID>{ small, wide });
+			}
+		}
+		WHEN("Points in other cells of the wide rectangle are queried")
+		{
+			vector<PostID> result;
+			grid.QueryPoint(ImVec2(410.f, 40.f), result);
+			grid.QueryPoint(ImVec2(410.f, 90.f), result);
+			grid.QueryPoint(ImVec2(-4950.f, -4950.f), result);
+
+			THEN("Only rectangles that contain them are reported")
+			{
+				REQUIRE(result == vector<PostID>{ wide, far_away });
+			}
+		}
+		WHEN("A rectangle is moved to other cells")
+		{
+			grid.Update(wide, ImRect(1000.f, 1000.f, 1100.f, 1100.f));
+
+			THEN("It is only found at its new place")
+			{
+				vector<PostID> result;
+				grid.QueryPoint(ImVec2(30.f, 30.f), result);
+				REQUIRE(result == vector<PostID>{ small });
+
+				result.clear();
+				grid.QueryPoint(ImVec2(1050.f, 1050.f), result);
+				REQUIRE(result == vector<PostID>{ wide });
+				REQUIRE(grid.size() == 3);
+			}
+		}
+		WHEN("A rectangle is removed")
+		{
+			grid.Remove(small);
+			grid.Remove(small);
+
+			THEN("It is not reported anymore")
+			{
+				vector<PostID> result;
+				grid.QueryPoint(ImVec2(30.f, 30.f), result);
+				REQUIRE(result == vector<PostID>{ wide });
+				REQUIRE_FALSE(grid.Contains(small));
+				REQUIRE(grid.size() == 2);
+			}
+		}
+	}
+}
+
+SCENARIO("Area queries report every overlapping rectangle exactly once", tag)
+{
+	GIVEN("A grid with rectangles spanning several cells")
+	{
+		SpatialGrid grid(100.f);
+		const PostID a{ 0, 1 };
+		const PostID b{ 1, 1 };
+		const PostID c{ 2, 1 };
+
+		grid.Update(a, ImRect(0.f, 0.f, 350.f, 350.f));
+		grid.Update(b, ImRect(250.f, 250.f, 260.f, 260.f));
+		grid.Update(c, ImRect(900.f, 900.f, 950.f, 950.f));
+
+		WHEN("An area covering part of the grid is queried")
+		{
+			vector<PostID> result;
+			grid.QueryRect(ImRect(120.f, 120.f, 480.f, 480.f), result);
+
+			THEN("Overlapping rectangles are reported once")
+			{
+				REQUIRE(Sorted(result) == vector<PostID>{ a, b });
+			}
+		}
+		WHEN("An area much bigger than the occupied cells is queried")
+		{
+			vector<PostID> result;
+			grid.QueryRect(ImRect(-100000.f, -100000.f, 100000.f, 100000.f), result);
+
+			THEN("Every rectangle is reported once")
+			{
+				REQUIRE(Sorted(result) == vector<PostID>{ a, b, c });
+			}
+		}
+		WHEN("The grid is cleared")
+		{
+			grid.Clear();
+
+			THEN("Nothing is reported")
+			{
+				vector<PostID> result;
+				grid.QueryRect(ImRect(0.f, 0.f, 1000.f, 1000.f), result);
+				REQUIRE(result.empty());
+				REQUIRE(grid.size() == 0);
+			}
+		}
+	}
+}
\ No newline at end of file
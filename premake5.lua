@@ -1,3 +1,8 @@
+newoption{
+	trigger = "profile",
+	description = "Keep the frame profiler timers in Release builds",
+}
+
 workspace "BoardsBoardsBoards"
 	startproject "BoardsBoardsBoards"
 	architecture "x86"
@@ -5,9 +10,17 @@ workspace "BoardsBoardsBoards"
 		"Debug",
 		"Release"
 	}
-	platforms{ 
-		"Win32"
-	}
+	-- Only the Tests project builds on Linux: premake5 gmake2 && make Tests config=debug_x64
+	if os.target() == "linux" then
+		platforms{
+			"x64"
+		}
+		architecture "x86_64"
+	else
+		platforms{ 
+			"Win32"
+		}
+	end
 
 output_dir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 target_dir = ("bin/" .. output_dir .. "/%{prj.name}")
@@ -99,10 +112,14 @@ project "BoardsBoardsBoards"
 				"nfd.lib"
 			}
 
+		filter "options:profile"
+			defines "BOARD_PROFILE"
+
 project "Tests"
 	location "Tests"
 	kind "ConsoleApp"
 	language "C++"
+	defines{"IMGUI_DEFINE_MATH_OPERATORS", "BOARD_COUNT_ALLOCATIONS"}
 
 	targetdir (target_dir)
 	objdir ("bin-int/" .. output_dir .. "/%{prj.name}")
@@ -112,9 +129,9 @@ project "Tests"
 		("{COPYDIR} ../BoardsBoardsBoards/scripts/serpent ../" .. target_dir .. "/scripts/serpent"),
 	}
 
-	links { "BoardsBoardsBoards", "PostContainer.obj", "LuaStack.obj", "ParsingStrategies.obj", "lua54.lib" }
 	files{
 		"%{prj.name}/**.cpp",
+		"BoardsBoardsBoards/src/utils/AllocationCounter.cpp", -- Built here with BOARD_COUNT_ALLOCATIONS, the app's object only counts in Debug
 
 	}
 	includedirs{
@@ -124,6 +141,138 @@ project "Tests"
 		"BoardsBoardsBoards/extern/sol",
 		"BoardsBoardsBoards/extern/imgui/",
 	}
+
+	filter "system:windows"
+		cppdialect "C++latest"
+		systemversion "latest"
+
+		defines{
+			"WIN32",
+		}
+
+		links { "BoardsBoardsBoards", "BoardGenerator.obj", "PostContainer.obj", "SpatialGrid.obj", "BoundingVolumeHierarchy.obj", "LuaStack.obj", "ParsingStrategies.obj", "BinaryBoardFormat.obj", "MappedFile.obj", "LuaBoardReader.obj", "LuaBoardWriter.obj", "BoardLoader.obj", "WorkerPool.obj", "EditHistory.obj", "BoardTab.obj", "HeadlessDriver.obj", "FrameProfiler.obj", "imgui.obj", "imgui_draw.obj", "imgui_widgets.obj", "imgui_tables.obj", "imgui_stdlib.obj", "lua54.lib" }
+		libdirs{
+			"bin-int/" .. output_dir .. "/BoardsBoardsBoards",
+			"BoardsBoardsBoards/extern/Lua/lib",
+		}
+
+		filter "platforms:x86"
+        	system "Windows"
+        	architecture "x86"
+
+		-- The app only builds on Windows, so Tests compiles the sources it needs and links the system's Lua 5.4
+		filter "system:linux"
+			cppdialect "C++20"
+			files{
+				"BoardsBoardsBoards/src/containers/PostContainer.cpp",
+				"BoardsBoardsBoards/src/containers/SpatialGrid.cpp",
+				"BoardsBoardsBoards/src/containers/BoundingVolumeHierarchy.cpp",
+				"BoardsBoardsBoards/src/containers/EditHistory.cpp",
+				"BoardsBoardsBoards/src/utils/BoardGenerator.cpp",
+				"BoardsBoardsBoards/src/utils/LuaStack.cpp",
+				"BoardsBoardsBoards/src/utils/MappedFile.cpp",
+				"BoardsBoardsBoards/src/utils/WorkerPool.cpp",
+				"BoardsBoardsBoards/src/utils/FrameProfiler.cpp",
+				"BoardsBoardsBoards/src/utils/parsing/ParsingStrategies.cpp",
+				"BoardsBoardsBoards/src/utils/parsing/BinaryBoardFormat.cpp",
+				"BoardsBoardsBoards/src/utils/parsing/LuaBoardReader.cpp",
+				"BoardsBoardsBoards/src/utils/parsing/LuaBoardWriter.cpp",
+				"BoardsBoardsBoards/src/utils/parsing/BoardLoader.cpp",
+				"BoardsBoardsBoards/src/renderables/tabs/BoardTab.cpp",
+				"BoardsBoardsBoards/src/renderables/HeadlessDriver.cpp",
+				"BoardsBoardsBoards/extern/imgui/imgui.cpp",
+				"BoardsBoardsBoards/extern/imgui/imgui_draw.cpp",
+				"BoardsBoardsBoards/extern/imgui/imgui_widgets.cpp",
+				"BoardsBoardsBoards/extern/imgui/imgui_tables.cpp",
+				"BoardsBoardsBoards/extern/imgui/misc/cpp/imgui_stdlib.cpp",
+			}
+			includedirs{
+				"BoardsBoardsBoards/extern/imgui/misc/cpp",
+			}
+			links{
+				"lua5.4",
+				"pthread",
+			}
+
+		filter "configurations:Debug"
+			defines "BOARD_DEBUG"
+			symbols "On"
+			runtime "Debug"
+
+		filter "configurations:Release"
+			defines "BOARD_RELEASE"
+			optimize "On"
+			runtime "Release"
+
+project "Benchmarks"
+	location "Benchmarks"
+	kind "ConsoleApp"
+	language "C++"
+	defines{"IMGUI_DEFINE_MATH_OPERATORS"}
+
+	targetdir (target_dir)
+	objdir ("bin-int/" .. output_dir .. "/%{prj.name}")
+	debugdir ("bin/" .. output_dir .. "/%{prj.name}")
+
+	links { "BoardsBoardsBoards", "BoardGenerator.obj", "PostContainer.obj", "LuaStack.obj", "ParsingStrategies.obj", "BinaryBoardFormat.obj", "MappedFile.obj", "LuaBoardReader.obj", "LuaBoardWriter.obj", "imgui.obj", "imgui_draw.obj", "imgui_widgets.obj", "imgui_tables.obj", "lua54.lib" }
+	files{
+		"%{prj.name}/**.hpp",
+		"%{prj.name}/**.cpp",
+	}
+	includedirs{
+		"BoardsBoardsBoards/src/",
+		"BoardsBoardsBoards/extern/Lua/include",
+		"BoardsBoardsBoards/extern/sol",
+		"BoardsBoardsBoards/extern/imgui/",
+	}
+	libdirs{
+		"bin-int/" .. output_dir .. "/BoardsBoardsBoards",
+		"BoardsBoardsBoards/extern/Lua/lib",
+	}
+
+	filter "system:windows"
+		cppdialect "C++latest"
+		systemversion "latest"
+
+		defines{
+			"WIN32",
+		}
+
+		filter "platforms:x86"
+        	system "Windows"
+        	architecture "x86"
+
+		filter "configurations:Debug"
+			defines "BOARD_DEBUG"
+			symbols "On"
+			runtime "Debug"
+
+		filter "configurations:Release"
+			defines "BOARD_RELEASE"
+			optimize "On"
+			runtime "Release"
+
+project "Generator"
+	location "Generator"
+	kind "ConsoleApp"
+	language "C++"
+	defines{"IMGUI_DEFINE_MATH_OPERATORS"}
+
+	targetdir (target_dir)
+	objdir ("bin-int/" .. output_dir .. "/%{prj.name}")
+	debugdir ("bin/" .. output_dir .. "/%{prj.name}")
+
+	links { "BoardsBoardsBoards", "BoardGenerator.obj", "PostContainer.obj", "LuaStack.obj", "ParsingStrategies.obj", "BinaryBoardFormat.obj", "MappedFile.obj", "LuaBoardReader.obj", "LuaBoardWriter.obj", "imgui.obj", "imgui_draw.obj", "imgui_widgets.obj", "imgui_tables.obj", "lua54.lib" }
+	files{
+		"%{prj.name}/**.hpp",
+		"%{prj.name}/**.cpp",
+	}
+	includedirs{
+		"BoardsBoardsBoards/src/",
+		"BoardsBoardsBoards/extern/Lua/include",
+		"BoardsBoardsBoards/extern/sol",
+		"BoardsBoardsBoards/extern/imgui/",
+	}
 	libdirs{
 		"bin-int/" .. output_dir .. "/BoardsBoardsBoards",
 		"BoardsBoardsBoards/extern/Lua/lib",